@@ -1,10 +1,16 @@
 /*
  * Pop Tart Cat animation frames
+ *
+ * The rainbow is left out, as its stripes depend on the flag. Cells
+ * marked 0 or 1 are part of it: on row y they take color y - 23 or
+ * y - 22 of the flag's rainbow, the same stripes that make up the
+ * tail left of the frame (see the tail[] table, build_tail() and
+ * select_rainbow() in render.c).
  */
-#ifndef ANIMATION5_H
-#define ANIMATION5_H
+#ifndef ANIMATION_H
+#define ANIMATION_H
 
-const char * frame0_5[] = {
+const char * frame0[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,.,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -29,23 +35,23 @@ const char * frame0_5[] = {
 ",.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-",,>>>>>>>>,,,,,,,,>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-">>&&&&&&&&>>>>>>>>&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
-"&&++++++++&&&&&&&&'''++'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++**''+'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'**'''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
-"++########++++++++''**''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
-"###################''**'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
-"####################''''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
-"##========########====''@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
-"======================='@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
-"==,,,,,,,,.=======,,,,'''@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,'***''''''''''''''''''',,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,'**'','*',,,,,'*','**',,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,.,,,,,.,,,,,,,'''',,'',,,,,,,'',,'',,,,,,,,,,,,,,,,,,,,,,",
+",,11111111,,,,,,,,111111'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
+"001111111100000000'''11'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
+"001111111100000000**''1'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
+"001111111100000000'**'''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
+"001111111100000000''**''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
+"0011111111000000001''**'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
+"00111111110000000011''''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
+"0011111111000000001111''@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
+"0011111111.00000001111'''@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,,",
+"001111111100000000111'***''''''''''''''''''',,,,,,,,,,,,,,,,,,,,",
+"001111111100000000111'**'','*',,,,,'*','**',,,,,,,,,,,,,,,,,,,,,",
+"00,,,,,.,,000.0000,,,'''',,'',,,,,,,'',,'',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -68,9 +74,10 @@ const char * frame0_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,..,..,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame1_5[] = {
+const char * frame1[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,..,..,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -95,23 +102,23 @@ const char * frame1_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-",,>>>>>>>>,,,,,,,,>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-">>&&&&&&&&>>>>>>>>&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
-"&&++++++++&&&&&&&&+++++'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++'+++'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'*'++'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
-"++########++++++++'*''''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
-"###################****'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
-"###################''**'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
-"##========########==='''@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
-"======================='@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
-"==,,,,,,,,========,,,,,''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**','*',,,,,,**','**',,,,,,,,,,,,,,,,,,,,",
-",,,,,.,,,,,,,,,,,,,,,,''',,,'',,,,,,''',,''',,,,,,,,,,,,,,,,,,,,",
+",,11111111,,,,,,,,111111'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
+"0011111111000000001'111'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
+"001111111100000000'*'11'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
+"001111111100000000'*''''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
+"0011111111000000001****'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
+"0011111111000000001''**'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
+"001111111100000000111'''@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
+"00111111110000000011111''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
+"0011111111000000001111'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
+"0011111111000000001111'**','*',,,,,,**','**',,,,,,,,,,,,,,,,,,,,",
+"00,,,.,,,,00000000,,,,''',,,'',,,,,,''',,''',,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -134,9 +141,10 @@ const char * frame1_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,..,,..,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame2_5[] = {
+const char * frame2[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,..,.,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -161,23 +169,23 @@ const char * frame2_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.",
-">>,,,,,,,>>>>>>>>,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-"&&>>>>>>>&&&&&&&&>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
-"++&&&&&&&++++++++&&&&&&'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
-"##+++++++########++++++'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
-"######################''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
-"###################'''''@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
-"==#######========#'****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
-"==================='''='@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
-",,=======,,,,,,,,======'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
-",.,,,,,,,,,,,,,,,,,,,,,'*'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
-".,.,,,,,,,,,,,,,,,,,,,,'**',**',,,,,,**','**',,,,,,,,,,,,,,,,,,,",
+"11,,,,,,,11111111,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"110000000111111110000000'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
+"1100000001111111100000''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
+"1100000001111111100'''''@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
+"110000000111111110'****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
+"1100000001111111101'''1'@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
+"11000000011111111000000''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
+"1.000000011111111000000'*'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
+".,.000000,,,,,,,,000000'**',**',,,,,,**','**',,,,,,,,,,,,,,,,,,,",
 ",.,,,,,,,,,,,,,,,,,,,,,''',,''',,,,,,''',,''',,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -200,9 +208,10 @@ const char * frame2_5[] = {
 ",,,,,,,,,,,,,,,,,.,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame3_5[] = {
+const char * frame3[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,.,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -227,23 +236,23 @@ const char * frame3_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,.,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,",
-">>,,,,,,,>>>>>>>>,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-"&&>>>>>>>&&&&&&&&>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
-"++&&&&&&&++++++++&&&&&&'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
-"##+++++++########++++++'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
-"#####################'''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
-"###################''**'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
-"==#######========##****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
-"=================='*'=='@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
-",,=======,,,,,,,,=='==='@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**','*',,,,,,'*','**',,,,,,,,,,,,,,,,,,,,",
+"11,,,,,,,11111111,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"110000000111111110000000'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
+"110000000111111110000'''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
+"1100000001111111100''**'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
+"1100000001111111100****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
+"110000000111111110'*'00'@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
+"1100000001111111100'000'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
+"11000000011111111000000''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
+"1100000001111111100000'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
+",,0000000,,,,,,,,00000'**','*',,,,,,'*','**',,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,''',,,'',,,,,,,'',,''',,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -266,9 +275,10 @@ const char * frame3_5[] = {
 ",,,,,,,,.,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame4_5[] = {
+const char * frame4[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,.,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -293,23 +303,23 @@ const char * frame4_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,",
-",,>>>>>>>>,,,,,,,,>>>>>>>''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>&&&&&&&&>>>>>>>>&&&&&'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
-"&&++++++++&&&&&&&&+++++'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'''++'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
-"++########+++++++'**''''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
-"#################'****''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
-"##################''''*'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
-"##========########==='''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
-"======================='@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
-"==,,,,,,,,========,,,,''@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,''''@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,'***'''''''''''''''''''',,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,'**','**,,,,,,'**,'**',,,,,,,,,,,,,,,,,,,,,,",
+",,11111111,,,,,,,,1111111''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"001111111100000000111111'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
+"001111111100000000'''11'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
+"00111111110000000'**''''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
+"00111111110000000'****''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
+"001111111100000000''''*'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
+"001111111100000000111'''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
+"0011111111000000001111''@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
+"001111111100000000111''''@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,,",
+"00111111110000000011'***'''''''''''''''''''',,,,,,,,,,,,,,,,,,,,",
+"00,,,,,,,,00000000,,'**','**,,,,,,'**,'**',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,''',,,'',,,,,,,'',,''',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -332,9 +342,10 @@ const char * frame4_5[] = {
 ",,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame5_5[] = {
+const char * frame5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -359,23 +370,23 @@ const char * frame5_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,>>>>>>>>,,,,,,,,>>>>>>>''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>&&&&&&&&>>>>>>>>&&&&&'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$''$$$@@','',,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$'**'-$$@''**',,,,,,,,,,,,,,,,,,",
-"&&++++++++&&&&&&&&+++++'@$$$$$$$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++'+++'@$$$$$-$$'***''''****',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'*'++'@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
-"++########++++++++'*''''@$$$$$$$'*************',,,,,,,,,,,,,,,,,",
-"###################****'@$$$$$$-'***.'****.'**',,,,,,,,,,,,,,,,,",
-"###################''**'@$-$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
-"##========########==='''@$$$$$$$'*%%********%%',,,,,,,,,,,,,,,,,",
-"======================='@@$$$-$$$'***''''''**',,,,,,,,,,,,,,,,,,",
-"==,,,,,,,,========,,,,''@@@$$$$$$$'*********',,,,,,,,,,,,,,,,,,.",
-",,,,,,,,,,,,,,,,,,,,,'*''@@@@@@@@@@''''''''',,,,,,,,,,,,,,,,,,,.",
-",,,,,,,,,,,,,,,,,,,,'***''''''''''''''''*',,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,'**','**,,,,,,'**,'**',,,,,,,,,,,,,,,,,,..,.",
+",,11111111,,,,,,,,1111111''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"001111111100000000111111'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$$$-$$''$$$@@','',,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$-$$$$$'**'-$$@''**',,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
+"0011111111000000001'111'@$$$$$-$$'***''''****',,,,,,,,,,,,,,,,,,",
+"001111111100000000'*'11'@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
+"001111111100000000'*''''@$$$$$$$'*************',,,,,,,,,,,,,,,,,",
+"0011111111000000001****'@$$$$$$-'***.'****.'**',,,,,,,,,,,,,,,,,",
+"0011111111000000001''**'@$-$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
+"001111111100000000111'''@$$$$$$$'*%%********%%',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$-$$$'***''''''**',,,,,,,,,,,,,,,,,,",
+"0011111111000000001111''@@@$$$$$$$'*********',,,,,,,,,,,,,,,,,,.",
+"001111111100000000111'*''@@@@@@@@@@''''''''',,,,,,,,,,,,,,,,,,,.",
+"00111111110000000011'***''''''''''''''''*',,,,,,,,,,,,,,,,,,,,,,",
+"00,,,,,,,,00000000,,'**','**,,,,,,'**,'**',,,,,,,,,,,,,,,,,,..,.",
 ",,,,,,,,,,,,,,,,,,,,''',,''',,,,,,''',,''',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.",
@@ -398,9 +409,10 @@ const char * frame5_5[] = {
 ",.,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame6_5[] = {
+const char * frame6[] = {
 ".,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ".,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -425,23 +437,23 @@ const char * frame6_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>,,,,,,,>>>>>>>>,,,,,,,'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&>>>>>>>&&&&&&&&>>>>>>'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
-"++&&&&&&&++++++++&'''&&'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'*''+'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'**'''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
-"##+++++++########++'**''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
-"###################''**'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
-"####################''''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
-"==#######========#####''@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
-"======================='@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
-",,=======,,,,,,,,====='''@@@@@@@@@'*********',,,,,,,,,,,.,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,'***''''''''''''''''''',,,,,,,,,,.,,,.,,,,,",
-",,,,,,,,,,,,,,,,,,,,,'**'','*',,,,,'**,'**',,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,'''',,'',,,,,,,'',,'',,,,,,,,,,,.,,,,,.,,,,",
+"11,,,,,,,11111111,,,,,,,'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
+"110000000111111110'''00'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
+"110000000111111110'*''0'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
+"110000000111111110'**'''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
+"1100000001111111100'**''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
+"1100000001111111100''**'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
+"11000000011111111000''''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
+"1100000001111111100000''@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
+"1100000001111111100000'''@@@@@@@@@'*********',,,,,,,,,,,.,,,,,,,",
+"110000000111111110000'***''''''''''''''''''',,,,,,,,,,.,,,.,,,,,",
+"110000000111111110000'**'','*',,,,,'**,'**',,,,,,,,,,,,,,,,,,,,,",
+",,0000000,,,,,,,,0000'''',,'',,,,,,,'',,'',,,,,,,,,,,.,,,,,.,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,.,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,",
@@ -464,9 +476,10 @@ const char * frame6_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame7_5[] = {
+const char * frame7[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -491,23 +504,23 @@ const char * frame7_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>,,,,,,,>>>>>>>>,,,,,,,'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&>>>>>>>&&&&&&&&>>>>>>'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
-"++&&&&&&&++++++++&&&&&&'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++'+++'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'*'++'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
-"##+++++++########+'*''''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
-"###################****'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
-"###################''**'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
-"==#######========####'''@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
-"======================='@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
-",,=======,,,,,,,,======''@@@@@@@@@@'*********',,,.,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**','*',,,,,,**','**',,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,''',,,'',,,,,,''',,''',,.,,,,.,,,,,,,,,,,,",
+"11,,,,,,,11111111,,,,,,,'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
+"1100000001111111100'000'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
+"110000000111111110'*'00'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
+"110000000111111110'*''''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
+"1100000001111111100****'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
+"1100000001111111100''**'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
+"110000000111111110000'''@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
+"11000000011111111000000''@@@@@@@@@@'*********',,,.,,,,,,,,,,,,,,",
+"1100000001111111100000'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
+"1100000001111111100000'**','*',,,,,,**','**',,,,,,,,,,,,,,,,,,,,",
+",,0000000,,,,,,,,00000''',,,'',,,,,,''',,''',,.,,,,.,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,",
@@ -530,9 +543,10 @@ const char * frame7_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,..,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame8_5[] = {
+const char * frame8[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,.,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -557,23 +571,23 @@ const char * frame8_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,>>>>>>>>,,,,,,,,>>>>>>>''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>&&&&&&&&>>>>>>>>&&&&&'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
-"&&++++++++&&&&&&&&+++++'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
-"++########++++++++#####'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
-"######################''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
-"###################'''''@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
-"##========########'****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
-"==================='''='@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
-"==,,,,,,,,========,,,,,'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,'*'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,'**',**',,,,,,**'.'**',,,,,,,,,,,,,,,,,,,",
+",,11111111,,,,,,,,1111111''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"001111111100000000111111'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
+"0011111111000000001111''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
+"0011111111000000001'''''@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
+"001111111100000000'****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
+"0011111111000000001'''1'@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
+"00111111110000000011111''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'*'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
+"00,,,,,,,,00000000,,,,,'**',**',,,,,,**'.'**',,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,''',,''',,,,,,''',,''',,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -596,9 +610,10 @@ const char * frame8_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,.,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,",
+};
 
-const char * frame9_5[] = {
+const char * frame9[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,.,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -623,23 +638,23 @@ const char * frame9_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,>>>>>>>>,,,,,,,,>>>>>>>''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-">>&&&&&&&&>>>>>>>>&&&&&'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
-"&&++++++++&&&&&&&&+++++'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
-"++########++++++++#####'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
-"#####################'''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
-"###################''**'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
-"##========########=****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
-"=================='*'=='@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
-"==,,,,,,,,========,',,,'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,'**','*',,..,.**','**',,,,,,,,,,,,,,,,,,,,",
+",,11111111,,,,,,,,1111111''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"001111111100000000111111'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$-$$$$$$$''-$$@',,'',,,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$$'**'$$@','**',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$-$$$'***$$@''***',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,",
+"00111111110000000011111'@$$$$$$$$$'***********',,,,,,,,,,,,,,,,,",
+"001111111100000000111'''@$$$$$$-$'*************',,,,,,,,,,,,,,,,",
+"0011111111000000001''**'@$-$$$$$$'***.'****.'**',,,,,,,,,,,,,,,,",
+"0011111111000000001****'@$$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,",
+"001111111100000000'*'11'@@$$$-$$$'*%%********%%',,,,,,,,,,,,,,,,",
+"0011111111000000001'111'@@@$$$$$$$'***''''''**',,,,,,,,,,,,,,,,,",
+"00111111110000000011111''@@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,",
+"0011111111000000001111'**'''''''''''''''''''',,,,,,,,,,,,,,,,,,,",
+"00,,,,,,,,00000000,,,,'**','*',,..,.**','**',,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,''',,,'',,,,.,''',,''',,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -662,9 +677,10 @@ const char * frame9_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,.,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,",
+};
 
-const char * frame10_5[] = {
+const char * frame10[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,.,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -689,23 +705,23 @@ const char * frame10_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-">>,,,,,,,>>>>>>>>,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-"&&>>>>>>>&&&&&&&&>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
-"++&&&&&&&++++++++&&&&&&'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++++++'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'''++'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
-"##+++++++########'**''''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
-"#################'****''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
-"##################''''*'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
-"==#######========####'''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
-"======================='@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
-",,=======,,,,,,,,=====''@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,''''@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,'***'''''''''''''''''''',,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,'**'.'**..,,,,'**''**',,,,,,,,,,,,,,,,,,,,,,",
+"11,,,,,,,11111111,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"110000000111111110000000'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@$$$$$-$$-$$$$@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$-$$$$$$''$-$$@','',,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$'**'$$$@''**',,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$-$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
+"110000000111111110'''00'@$$$$$$$$'***''''****',,,,,,,,,,,,,,,,,,",
+"11000000011111111'**''''@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
+"11000000011111111'****''@$$$$$$-'*************',,,,,,,,,,,,,,,,,",
+"110000000111111110''''*'@$-$$$$$'***.'****.'**',,,,,,,,,,,,,,,,,",
+"110000000111111110000'''@$$$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@$$$-$$'*%%********%%',,,,,,,,,,,,,,,,,",
+"1100000001111111100000''@@@$$$$$$'***''''''**',,,,,,,,,,,,,,,,,,",
+"110000000111111110000''''@@@@@@@@@'*********',,,,,,,,,,,,,,,,,,,",
+"11000000011111111000'***'''''''''''''''''''',,,,,,,,,,,,,,,,,,,,",
+",,0000000,,,,,,,,000'**'.'**..,,,,'**''**',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,''',,,'',,,,,,,''',''',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -728,9 +744,10 @@ const char * frame10_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char * frame11_5[] = {
+const char * frame11[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -755,23 +772,23 @@ const char * frame11_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-">>,,,,,,,>>>>>>>>,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
-">>>>>>>>>>>>>>>>>>>>>>>>'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
-"&&>>>>>>>&&&&&&&&>>>>>>'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@@$$$$$-$$''$$$@@','',,,,,,,,,,,,,,,,,,,",
-"&&&&&&&&&&&&&&&&&&&&&&&'@$$-$$$$$'**'-$$@''**',,,,,,,,,,,,,,,,,,",
-"++&&&&&&&++++++++&&&&&&'@$$$$$$$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
-"+++++++++++++++++++'+++'@$$$$$-$$'***''''****',,,,,,,,,,,,,,,,,,",
-"++++++++++++++++++'*'++'@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
-"##+++++++########+'*''''@$$$$$$$'*************',,,,,,,,,,,,,,,,,",
-"###################****'@$$$$$$-'***.'****.'**',,,,,,,,,,,,,,,,,",
-"###################''**'@$-$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
-"==#######========####'''@$$$$$$$'*%%********%%',,,,,,,,,,,,,,,,,",
-"======================='@@$$$-$$$'***''''''**',,,,,,,,,,,,,,,,,,",
-",,=======,,,,,,,,=.===''@@@$$$$$$$'*********',,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,.'*''@@@@@@@@@@''''''''',,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,'***''''''''''''''''*',,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,.,,,'**','**,,,,,,'**''**',,,,,,,,,,,,,,,,,,,,,,",
+"11,,,,,,,11111111,,,,,,,,''''''''''''''',,,,,,,,,,,,,,,,,,,,,,,,",
+"110000000111111100000000'@@@@@@@@@@@@@@@',,,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@@$$$$$$$$$$$@@@',,,,,,,,,,,,,,,,,,,,,,",
+"11000000011111110000000'@@$$$$$-$$''$$$@@','',,,,,,,,,,,,,,,,,,,",
+"11000000011111110000000'@$$-$$$$$'**'-$$@''**',,,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@$$$$$$$$'***$$$@'***',,,,,,,,,,,,,,,,,,",
+"1100000001111111000'000'@$$$$$-$$'***''''****',,,,,,,,,,,,,,,,,,",
+"110000000111111100'*'00'@$$$$$$$$'***********',,,,,,,,,,,,,,,,,,",
+"110000000111111110'*''''@$$$$$$$'*************',,,,,,,,,,,,,,,,,",
+"1100000001111111000****'@$$$$$$-'***.'****.'**',,,,,,,,,,,,,,,,,",
+"1100000001111111000''**'@$-$$$$$'***''**'*''**',,,,,,,,,,,,,,,,,",
+"110000000111111110000'''@$$$$$$$'*%%********%%',,,,,,,,,,,,,,,,,",
+"11000000011111111000000'@@$$$-$$$'***''''''**',,,,,,,,,,,,,,,,,,",
+"110000000111111110.000''@@@$$$$$$$'*********',,,,,,,,,,,,,,,,,,,",
+"11000000011111110000.'*''@@@@@@@@@@''''''''',,,,,,,,,,,,,,,,,,,,",
+"11000000011111110000'***''''''''''''''''*',,,,,,,,,,,,,,,,,,,,,,",
+",,0000000,,,,,,,.000'**','**,,,,,,'**''**',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,''',,''',,,,,,''',,''',,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
@@ -794,21 +811,22 @@ const char * frame11_5[] = {
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,.,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,.,,,,,,,,,,,,,,,,,,,,,,,",
 ",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
-",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,"};
+",,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+};
 
-const char ** frames_5[] = {
-	frame0_5,
-	frame1_5,
-	frame2_5,
-	frame3_5,
-	frame4_5,
-	frame5_5,
-	frame6_5,
-	frame7_5,
-	frame8_5,
-	frame9_5,
-	frame10_5,
-	frame11_5,
+const char ** frames[] = {
+	frame0,
+	frame1,
+	frame2,
+	frame3,
+	frame4,
+	frame5,
+	frame6,
+	frame7,
+	frame8,
+	frame9,
+	frame10,
+	frame11,
 	NULL
 };
 
@@ -0,0 +1,313 @@
+/*
+ * Flag definitions for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "flags.h"
+#include "render.h"
+
+/*
+ * xterm_table and ansi_table: the closest 256-color and 16-color
+ * entry for each 15-bit RGB value, worked out at build time.
+ */
+#include "quantizer.c"
+
+/*
+ * The built-in flags. Their 256 and 16 color matches were picked by
+ * hand, except for the lesbian flag on 16 colors.
+ */
+struct flag flag_table[MAX_FLAGS] = {
+    [L] = {"lesbian l", 5, {
+        {198, 59, 30, 166, 0},
+        {243, 160, 99, 215, 0},
+        {255, 255, 255, 231, 0},
+        {199, 106, 163, 169, 0},
+        {152, 31, 96, 89, 0},
+    }, {0}},
+    [G] = {"gay g", 6, {
+        {236, 51, 44, 202, 101},    /* Red */
+        {244, 168, 74, 215, 43},    /* Orange */
+        {255, 254, 104, 227, 103},  /* Yellow */
+        {53, 126, 43, 64, 102},     /* Green */
+        {0, 28, 239, 21, 104},      /* Light blue */
+        {123, 26, 121, 90, 45},     /* Purple */
+    }, {0}},
+    [B] = {"bisexual bi b", 3, {
+        {199, 43, 112, 161, 41},
+        {147, 84, 148, 96, 45},
+        {14, 56, 163, 25, 104},
+    }, {0}},
+    [T] = {"transgender trans t", 5, {
+        {120, 205, 246, 117, 106},  /* Blue */
+        {235, 174, 186, 217, 105},  /* Pink */
+        {255, 255, 255, 231, 107},  /* White */
+        {235, 174, 186, 217, 105},  /* Pink */
+        {120, 205, 246, 117, 106},  /* Blue */
+    }, {0}},
+    [Q] = {"queer q", 3, {
+        {175, 131, 215, 140, 105},
+        {255, 255, 255, 231, 107},
+        {86, 128, 48, 65, 102},
+    }, {0}},
+    [NB] = {"nonbinary non-binary nb", 4, {
+        {254, 243, 93, 227, 103},
+        {255, 255, 255, 231, 107},
+        {147, 95, 203, 98, 45},
+        {0, 0, 0, 16, 40},
+    }, {0}},
+    [A] = {"asexual ace a", 4, {
+        {0, 0, 0, 16, 40},
+        {164, 164, 164, 145, 47},
+        {255, 255, 255, 231, 107},
+        {119, 25, 125, 90, 45},
+    }, {0}},
+    [P] = {"pansexual pan-sexual pan p", 3, {
+        {236, 61, 140, 204, 105},
+        {250, 217, 74, 221, 103},
+        {80, 177, 249, 75, 107},
+    }, {0}},
+};
+
+int flag_count = BUILTIN_FLAGS;
+
+/*
+ * Everything else in the animation, by the cell that shows it.
+ */
+static const struct {
+    char cell;
+    struct flag_color color;
+} cat_colors[] = {
+    {',',  {9, 22, 128, 18, 104}},      /* Blue background */
+    {'.',  {255, 255, 255, 231, 107}},  /* White stars */
+    {'\'', {0, 0, 0, 16, 40}},          /* Black border */
+    {'@',  {248, 206, 160, 223, 47}},   /* Tan poptart */
+    {'$',  {242, 160, 250, 219, 105}},  /* Pink poptart */
+    {'-',  {236, 74, 151, 204, 101}},   /* Red poptart */
+    {'*',  {154, 154, 154, 102, 100}},  /* Gray cat face */
+    {'%',  {242, 158, 156, 217, 105}},  /* Pink cheeks */
+};
+
+/*
+ * How the rows are shared out when a flag doesn't say, for the
+ * stripe counts the animation was originally drawn with.
+ */
+static const int default_rows[][MAX_STRIPES] = {
+    [3] = {5, 6, 5},
+    [4] = {4, 4, 4, 4},
+    [5] = {2, 3, 3, 3, 2},
+    [6] = {2, 3, 3, 3, 2, 3},
+};
+
+/*
+ * Parse a stripe: RRGGBB, maybe after a #, and maybe followed by
+ * :rows. Returns -1 if there is anything else in it.
+ */
+static int parse_stripe(const char *s, unsigned char *rgb, int *rows) {
+    char *end;
+    int k;
+    if (*s == '#') ++s;
+    for (k = 0; k < 6; ++k) {
+        if (!isxdigit((unsigned char) s[k])) return -1;
+    }
+    for (k = 0; k < 3; ++k) {
+        char byte[3] = {s[2 * k], s[2 * k + 1], 0};
+        rgb[k] = strtol(byte, NULL, 16);
+    }
+    s += 6;
+    *rows = 0;
+    if (*s == ':') {
+        if (!isdigit((unsigned char) s[1])) return -1;
+        *rows = (int) strtol(s + 1, &end, 10);
+        s = end;
+    }
+    return *s ? -1 : 0;
+}
+
+/*
+ * Read more flags from a file. Each line holds the names of a flag,
+ * separated by commas, followed by its stripes from top to bottom as
+ * RRGGBB colors, each optionally followed by :rows. For example:
+ *
+ *     # The Progress flag, without the chevron
+ *     progress,prog  e40303 ff8c00 ffed00 008026 24408e 732982
+ *
+ * Blank lines and lines starting with # are skipped, and a # on its
+ * own after the stripes starts a comment. Only the RGB
+ * colors are given, the closest match is used on other terminals.
+ * Returns the number of flags read, or -1 if the file can't be read.
+ */
+int load_flags(const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[1024], *name;
+    int lineno = 0, loaded = 0;
+
+    if (!f) return -1;
+    while (fgets(line, sizeof(line), f)) {
+        char *token = strtok(line, " \t\r\n");
+        lineno++;
+        if (!token || token[0] == '#') continue;
+        if (flag_count == MAX_FLAGS) {
+            fprintf(stderr, "%s:%d: too many flags\n", path, lineno);
+            break;
+        }
+
+        struct flag *flag = &flag_table[flag_count];
+        memset(flag, 0, sizeof(*flag));
+        snprintf(flag->names, sizeof(flag->names), "%s", token);
+        for (name = flag->names; *name; ++name) {
+            if (*name == ',') *name = ' ';
+        }
+
+        while ((token = strtok(NULL, " \t\r\n"))) {
+            struct flag_color *color = &flag->stripes[flag->count];
+            if (!strcmp(token, "#")) break;
+            if (flag->count == MAX_STRIPES) {
+                fprintf(stderr, "%s:%d: more than %d stripes\n", path, lineno, MAX_STRIPES);
+                break;
+            }
+            if (parse_stripe(token, &color->r, &flag->rows[flag->count]) < 0) {
+                fprintf(stderr, "%s:%d: bad color %s\n", path, lineno, token);
+                flag->count = 0;
+                break;
+            }
+            color->xterm = -1;
+            color->ansi = 0;
+            flag->count++;
+        }
+        if (flag->count) {
+            flag_count++;
+            loaded++;
+        }
+    }
+    fclose(f);
+    return loaded;
+}
+
+/*
+ * Look a flag up by any of its names. Flags read from a file
+ * are searched first, so they can replace built-in ones.
+ */
+const struct flag *find_flag(const char *name) {
+    int i;
+    for (i = flag_count - 1; i >= 0; --i) {
+        const char *names = flag_table[i].names;
+        size_t len = strlen(name);
+        while (*names) {
+            size_t n = strcspn(names, " ");
+            if (n == len && !strncmp(names, name, len)) {
+                return &flag_table[i];
+            }
+            names += n;
+            names += strspn(names, " ");
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Lay the stripes out over the rows of the rainbow, as the cells
+ * (STRIPE_CELL) the renderer draws it with. The result starts two
+ * rows above the first stripe and has RAINBOW_ROWS + 2 entries.
+ */
+void flag_rainbow(const struct flag *flag, char *rainbow) {
+    int rows[MAX_STRIPES];
+    int k, left = RAINBOW_ROWS, shared = 0, y = 0;
+
+    for (k = 0; k < flag->count; ++k) {
+        rows[k] = flag->rows[k];
+        if (!rows[k] && flag->count < (int) (sizeof(default_rows) / sizeof(default_rows[0]))) {
+            rows[k] = default_rows[flag->count][k];
+        }
+        if (rows[k]) {
+            left -= rows[k];
+        } else {
+            shared++;
+        }
+    }
+    /* Share the remaining rows out evenly, the first stripes get any extra */
+    if (shared && left > 0) {
+        int each = left / shared, extra = left % shared;
+        for (k = 0; k < flag->count; ++k) {
+            if (!rows[k]) {
+                rows[k] = each + (extra-- > 0);
+            }
+        }
+    }
+
+    memset(rainbow, ',', RAINBOW_ROWS + 2);
+    rainbow[RAINBOW_ROWS + 2] = '\0';
+    for (k = 0; k < flag->count; ++k) {
+        while (rows[k]-- > 0 && y < RAINBOW_ROWS) {
+            rainbow[2 + y++] = STRIPE_CELL(k);
+        }
+    }
+}
+
+/*
+ * Entry of a quantizer table for a color.
+ */
+static int quantize(const struct flag_color *color, const unsigned char *table) {
+    return table[(color->r >> 3) << 10 | (color->g >> 3) << 5 | color->b >> 3];
+}
+
+static char escapes[256][24];
+static char fg_escapes[256][24];
+
+/*
+ * Set the escapes for a cell to a color, as the background and as
+ * the foreground, in the form the terminal type understands. Returns
+ * -1 if the terminal type has no colors.
+ */
+static int set_color(unsigned char cell, const struct flag_color *color, int ttype) {
+    switch (ttype) {
+        case 0:
+            snprintf(escapes[cell], sizeof(escapes[cell]), "\033[48;2;%d;%d;%dm", color->r, color->g, color->b);
+            snprintf(fg_escapes[cell], sizeof(fg_escapes[cell]), "\033[38;2;%d;%d;%dm", color->r, color->g, color->b);
+            break;
+        case 1: {
+            int xterm = color->xterm >= 0 ? color->xterm : quantize(color, xterm_table);
+            snprintf(escapes[cell], sizeof(escapes[cell]), "\033[48;5;%dm", xterm);
+            snprintf(fg_escapes[cell], sizeof(fg_escapes[cell]), "\033[38;5;%dm", xterm);
+            break;
+        }
+        case 2: {
+            int ansi = color->ansi;
+            if (!ansi) {
+                ansi = quantize(color, ansi_table);
+                ansi = ansi < 8 ? 40 + ansi : 100 + ansi - 8;
+            }
+            /* Foreground codes are the background ones less 10 */
+            snprintf(escapes[cell], sizeof(escapes[cell]), "\033[%dm", ansi);
+            snprintf(fg_escapes[cell], sizeof(fg_escapes[cell]), "\033[%dm", ansi - 10);
+            break;
+        }
+        default:
+            return -1;
+    }
+    colors[cell] = escapes[cell];
+    fg_colors[cell] = fg_escapes[cell];
+    return 0;
+}
+
+/*
+ * Fill in colors[] and fg_colors[] for the animation with a flag,
+ * for a terminal type. Returns -1 if the terminal can't show colors.
+ */
+int compile_palette(const struct flag *flag, int ttype) {
+    size_t k;
+    int stripe;
+
+    for (k = 0; k < sizeof(cat_colors) / sizeof(cat_colors[0]); ++k) {
+        if (set_color(cat_colors[k].cell, &cat_colors[k].color, ttype) < 0) return -1;
+    }
+    for (stripe = 0; stripe < flag->count; ++stripe) {
+        if (set_color(STRIPE_CELL(stripe), &flag->stripes[stripe], ttype) < 0) return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * Flag definitions for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef FLAGS_H
+#define FLAGS_H
+
+/*
+ * The built-in flags, in the order of flag_table.
+ */
+enum flag_type {
+    L=0, G=1, B=2, T=3, Q=4, NB=5, A=6, P=7
+};
+
+#define BUILTIN_FLAGS 8
+#define MAX_FLAGS     64
+#define MAX_STRIPES   18
+
+/*
+ * Rows the stripes of the rainbow share between them.
+ */
+#define RAINBOW_ROWS  18
+
+/*
+ * One color, with the closest match on terminals without true color.
+ * Those are hand-picked for the built-in flags, and worked out from
+ * the RGB value where they are left out (xterm < 0, ansi == 0).
+ */
+struct flag_color {
+    unsigned char r, g, b;
+    int xterm;      /* 256-color index */
+    int ansi;       /* 16-color background SGR */
+};
+
+/*
+ * A flag is its stripes from top to bottom, each taking up some rows
+ * of the rainbow. Stripes with rows set to 0 share what is left.
+ */
+struct flag {
+    char names[64];     /* Names accepted by -p, separated by spaces */
+    int count;
+    struct flag_color stripes[MAX_STRIPES];
+    int rows[MAX_STRIPES];
+};
+
+extern struct flag flag_table[MAX_FLAGS];
+extern int flag_count;
+
+int load_flags(const char *path);
+const struct flag *find_flag(const char *name);
+void flag_rainbow(const struct flag *flag, char *rainbow);
+int compile_palette(const struct flag *flag, int ttype);
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Build-time helper: works out the closest 256-color and 16-color
+ * terminal color for every 15-bit RGB value, and prints the two
+ * lookup tables as C source for flags.c.
+ *
+ * Colors are compared in the OKLab color space, where distance
+ * follows how different colors look much better than in RGB.
+ * The 256-color table leaves out the first 16 entries, as those
+ * follow the terminal's theme; the 16-color table has nothing else
+ * to go on, so it assumes xterm's default colors for them.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+struct lab {
+    double l, a, b;
+};
+
+static const unsigned char ansi_colors[16][3] = {
+    {0, 0, 0}, {205, 0, 0}, {0, 205, 0}, {205, 205, 0},
+    {0, 0, 238}, {205, 0, 205}, {0, 205, 205}, {229, 229, 229},
+    {127, 127, 127}, {255, 0, 0}, {0, 255, 0}, {255, 255, 0},
+    {92, 92, 255}, {255, 0, 255}, {0, 255, 255}, {255, 255, 255},
+};
+
+static double linear(int c) {
+    double v = c / 255.0;
+    return v <= 0.04045 ? v / 12.92 : pow((v + 0.055) / 1.055, 2.4);
+}
+
+static struct lab to_oklab(int r8, int g8, int b8) {
+    double r = linear(r8), g = linear(g8), b = linear(b8);
+    double l = cbrt(0.4122214708 * r + 0.5363325363 * g + 0.0514459929 * b);
+    double m = cbrt(0.2119034982 * r + 0.6806995451 * g + 0.1073969566 * b);
+    double s = cbrt(0.0883024619 * r + 0.2817188376 * g + 0.6299787005 * b);
+    struct lab lab;
+    lab.l = 0.2104542553 * l + 0.7936177850 * m - 0.0040720468 * s;
+    lab.a = 1.9779984951 * l - 2.4285922050 * m + 0.4505937099 * s;
+    lab.b = 0.0259040371 * l + 0.7827717662 * m - 0.8086757660 * s;
+    return lab;
+}
+
+static double distance(struct lab x, struct lab y) {
+    return (x.l - y.l) * (x.l - y.l) + (x.a - y.a) * (x.a - y.a) + (x.b - y.b) * (x.b - y.b);
+}
+
+static int nearest(struct lab color, const struct lab *palette, int first, int count) {
+    int best = first, i;
+    for (i = first + 1; i < first + count; ++i) {
+        if (distance(color, palette[i]) < distance(color, palette[best])) best = i;
+    }
+    return best;
+}
+
+static void print_table(const char *name, const unsigned char *table) {
+    int i;
+    printf("static const unsigned char %s[32768] = {", name);
+    for (i = 0; i < 32768; ++i) {
+        printf(i % 16 ? " %d," : "\n    %d,", table[i]);
+    }
+    printf("\n};\n\n");
+}
+
+int main(void) {
+    static const int levels[6] = {0, 95, 135, 175, 215, 255};
+    static struct lab xterm[256], ansi[16];
+    static unsigned char xterm_table[32768], ansi_table[32768];
+    int i;
+
+    for (i = 16; i < 256; ++i) {
+        if (i < 232) {
+            xterm[i] = to_oklab(levels[(i - 16) / 36], levels[(i - 16) / 6 % 6], levels[(i - 16) % 6]);
+        } else {
+            int gray = 8 + (i - 232) * 10;
+            xterm[i] = to_oklab(gray, gray, gray);
+        }
+    }
+    for (i = 0; i < 16; ++i) {
+        ansi[i] = to_oklab(ansi_colors[i][0], ansi_colors[i][1], ansi_colors[i][2]);
+    }
+
+    /* 5-bit channels are widened the usual way, so 0 and 31 stay black and white */
+    for (i = 0; i < 32768; ++i) {
+        int r = i >> 10, g = i >> 5 & 31, b = i & 31;
+        struct lab color = to_oklab(r << 3 | r >> 2, g << 3 | g >> 2, b << 3 | b >> 2);
+        xterm_table[i] = nearest(color, xterm, 16, 240);
+        ansi_table[i] = nearest(color, ansi, 0, 16);
+    }
+
+    printf("/*\n * Generated by make-quantizer, do not edit.\n */\n\n");
+    print_table("xterm_table", xterm_table);
+    print_table("ansi_table", ansi_table);
+    return 0;
+}
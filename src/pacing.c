@@ -0,0 +1,266 @@
+/*
+ * Frame pacing for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#define _XOPEN_SOURCE 700
+#define _DARWIN_C_SOURCE 1
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/ioctl.h>
+
+#include "pacing.h"
+
+static uint64_t monotonic_now(struct clock *clock) {
+    struct timespec ts;
+    (void) clock;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void monotonic_sleep_until(struct clock *clock, uint64_t deadline) {
+#if defined(_POSIX_TIMERS) && _POSIX_TIMERS > 0 && !defined(__APPLE__)
+    struct timespec ts;
+    (void) clock;
+    ts.tv_sec = deadline / 1000000000u;
+    ts.tv_nsec = deadline % 1000000000u;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+#else
+    /* No absolute sleep here, so recompute the remaining time after every wakeup */
+    uint64_t now;
+    while ((now = monotonic_now(clock)) < deadline) {
+        struct timespec ts;
+        ts.tv_sec = (deadline - now) / 1000000000u;
+        ts.tv_nsec = (deadline - now) % 1000000000u;
+        nanosleep(&ts, NULL);
+    }
+#endif
+}
+
+struct clock monotonic_clock = {monotonic_now, monotonic_sleep_until, 0};
+
+static uint64_t virtual_now(struct clock *clock) {
+    return clock->virtual_now;
+}
+
+static void virtual_sleep_until(struct clock *clock, uint64_t deadline) {
+    if (deadline > clock->virtual_now) {
+        clock->virtual_now = deadline;
+    }
+}
+
+void virtual_clock_init(struct clock *clock, uint64_t start) {
+    clock->now = virtual_now;
+    clock->sleep_until = virtual_sleep_until;
+    clock->virtual_now = start;
+}
+
+void pacer_start(struct pacer *pacer, struct clock *clock, uint64_t period) {
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->clock = clock;
+    pacer->period = period;
+    pacer->start = clock->now(clock);
+    pacer->last = pacer->start;
+    pacer->next = pacer->start + period;
+}
+
+/*
+ * Sleep until the next frame is due. If whole periods have already
+ * gone by, their deadlines are dropped rather than caught up on.
+ *
+ * Returns how many frames were skipped, so the caller can keep
+ * the animation where it would have been.
+ */
+uint64_t pacer_wait(struct pacer *pacer) {
+    uint64_t now = pacer->clock->now(pacer->clock);
+    uint64_t skipped = 0;
+
+    if (now >= pacer->next + pacer->period) {
+        skipped = (now - pacer->next) / pacer->period;
+        pacer->next += skipped * pacer->period;
+        pacer->skipped += skipped;
+    }
+    /* A sleep may end early (a signal, a coarse timer), never let a frame out before it is due */
+    while ((now = pacer->clock->now(pacer->clock)) < pacer->next) {
+        pacer->clock->sleep_until(pacer->clock, pacer->next);
+    }
+
+    /* Record how long the frame that just ended actually stayed up, skipped deadlines and all */
+    uint64_t period = now - pacer->last;
+    pacer->history[pacer->periods % PACING_HISTORY] = period;
+    pacer->period_sum += period;
+    pacer->periods++;
+    pacer->last = now;
+    pacer->next += pacer->period;
+    return skipped;
+}
+
+/*
+ * Time since the pacer started.
+ */
+uint64_t pacer_elapsed(struct pacer *pacer) {
+    return pacer->clock->now(pacer->clock) - pacer->start;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Print the mean achieved frame period and the 99th percentile
+ * of its deviation from the requested one, over recent frames.
+ * Periods that ran over deadlines given up on count at their full
+ * length, as that is how long the frame before stayed on screen.
+ */
+void pacer_report(FILE *out, const struct pacer *pacer) {
+    size_t n = pacer->periods < PACING_HISTORY ? pacer->periods : PACING_HISTORY;
+    uint64_t *jitter = malloc(n * sizeof(*jitter) + 1);
+    size_t k;
+
+    if (!jitter) return;
+    for (k = 0; k < n; ++k) {
+        uint64_t period = pacer->history[k];
+        jitter[k] = period > pacer->period ? period - pacer->period : pacer->period - period;
+    }
+    qsort(jitter, n, sizeof(*jitter), compare_u64);
+    fprintf(out, "frame period: %.3f ms mean, %.3f ms p99 jitter, %.3f ms requested, %llu deadlines skipped\n",
+            pacer->periods ? pacer->period_sum / (double) pacer->periods / 1e6 : 0.0,
+            n ? jitter[n * 99 / 100] / 1e6 : 0.0,
+            pacer->period / 1e6, (unsigned long long) pacer->skipped);
+    free(jitter);
+}
+
+void backlog_init(struct backlog *backlog, struct clock *clock, int fd_out, int fd_in,
+        uint64_t budget, int dsr) {
+    int queued;
+    memset(backlog, 0, sizeof(*backlog));
+    backlog->clock = clock;
+    backlog->fd_out = fd_out;
+    backlog->fd_in = fd_in;
+    backlog->budget = budget;
+#ifdef TIOCOUTQ
+    backlog->outq = ioctl(fd_out, TIOCOUTQ, &queued) == 0;
+#else
+    (void) queued;
+#endif
+    backlog->dsr = dsr;
+}
+
+/*
+ * Consume whatever the terminal sent back, counting complete
+ * cursor position reports. Anything else (keypresses) is ignored.
+ */
+static void backlog_read_replies(struct backlog *backlog) {
+    struct pollfd pfd = {backlog->fd_in, POLLIN, 0};
+    char input[256];
+    ssize_t n, k;
+
+    while (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) {
+        n = read(backlog->fd_in, input, sizeof(input));
+        if (n <= 0) break;
+        for (k = 0; k < n; ++k) {
+            char c = input[k];
+            switch (backlog->dsr_state) {
+                case 0:
+                    if (c == '\033') backlog->dsr_state = 1;
+                    break;
+                case 1:
+                    backlog->dsr_state = c == '[' ? 2 : 0;
+                    break;
+                default:
+                    if (c == 'R' && backlog->dsr_sent) {
+                        backlog->dsr_latency = backlog->clock->now(backlog->clock) - backlog->dsr_sent;
+                        backlog->dsr_sent = 0;
+                        backlog->dsr_answered = 1;
+                    }
+                    if (!((c >= '0' && c <= '9') || c == ';')) backlog->dsr_state = 0;
+                    break;
+            }
+        }
+    }
+}
+
+/*
+ * Whether the next frame should be left out because the terminal
+ * would not get to it within the latency budget.
+ */
+int backlog_congested(struct backlog *backlog) {
+    uint64_t now = backlog->clock->now(backlog->clock);
+    int congested = 0;
+
+    if (!backlog->budget) return 0;
+
+    if (backlog->dsr) {
+        backlog_read_replies(backlog);
+        if (backlog->dsr_sent && now - backlog->dsr_sent > backlog->budget) {
+            if (backlog->dsr_answered) {
+                congested = 1;
+            } else if (now - backlog->dsr_sent > 1000000000u) {
+                /* Nothing ever came back, this terminal doesn't answer */
+                backlog->dsr = 0;
+                backlog->dsr_sent = 0;
+            }
+        }
+    }
+
+#ifdef TIOCOUTQ
+    int queued;
+    if (backlog->outq && ioctl(backlog->fd_out, TIOCOUTQ, &queued) == 0) {
+        /*
+         * Only a queue that never ran dry says how fast it drains,
+         * otherwise the link was partly idle.
+         */
+        if (queued > 0 && queued < backlog->queued && now > backlog->queued_at) {
+            double rate = (backlog->queued - queued) / (double) (now - backlog->queued_at);
+            backlog->drain_rate = backlog->drain_rate ? 0.7 * backlog->drain_rate + 0.3 * rate : rate;
+        }
+        if (backlog->drain_rate) {
+            if (queued > backlog->drain_rate * backlog->budget) congested = 1;
+        } else if (queued && queued >= backlog->queued) {
+            /* Nothing at all went out since the last frame */
+            congested = 1;
+        }
+        backlog->queued = queued;
+        backlog->queued_at = now;
+    }
+#endif
+
+    if (congested) backlog->dropped++;
+    return congested;
+}
+
+/*
+ * Whether a position report should be requested after this frame.
+ * Only one is kept outstanding at a time.
+ */
+int backlog_probe(struct backlog *backlog) {
+    return backlog->budget && backlog->dsr && !backlog->dsr_sent;
+}
+
+void backlog_sent(struct backlog *backlog, size_t bytes, int probed) {
+    uint64_t now = backlog->clock->now(backlog->clock);
+    backlog->queued += bytes;
+    if (probed) backlog->dsr_sent = now;
+}
+
+/*
+ * Wait a little for an outstanding position report, so that it
+ * doesn't arrive after exit and end up in the shell's input.
+ */
+void backlog_settle(struct backlog *backlog, uint64_t timeout) {
+    uint64_t start = backlog->clock->now(backlog->clock);
+    while (backlog->dsr && backlog->dsr_sent) {
+        struct pollfd pfd = {backlog->fd_in, POLLIN, 0};
+        uint64_t waited = backlog->clock->now(backlog->clock) - start;
+        if (waited >= timeout || poll(&pfd, 1, (timeout - waited) / 1000000u + 1) <= 0) break;
+        backlog_read_replies(backlog);
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Frame pacing for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef PACING_H
+#define PACING_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * Number of recent frame periods kept for the jitter percentile.
+ */
+#define PACING_HISTORY 4096
+
+/*
+ * Source of time for the pacer, in nanoseconds. The monotonic clock
+ * really sleeps; a virtual clock jumps straight to the deadline, so
+ * pacing can run deterministically and as fast as possible.
+ */
+struct clock {
+    uint64_t (*now)(struct clock *clock);
+    void (*sleep_until)(struct clock *clock, uint64_t deadline);
+    uint64_t virtual_now;
+};
+
+extern struct clock monotonic_clock;
+
+void virtual_clock_init(struct clock *clock, uint64_t start);
+
+/*
+ * Frames are due at fixed multiples of the period from the start,
+ * so time spent rendering and writing does not add up into drift.
+ */
+struct pacer {
+    struct clock *clock;
+    uint64_t period;
+    uint64_t start;
+    uint64_t next;      /* Deadline of the next frame */
+    uint64_t last;      /* When the previous frame was due to go out */
+    uint64_t skipped;   /* Deadlines given up on so far */
+
+    /* Achieved frame periods */
+    uint64_t periods;
+    uint64_t period_sum;
+    uint64_t history[PACING_HISTORY];
+};
+
+/*
+ * Tracks how far the terminal is behind on output, so frames can be
+ * dropped before they pile up. Two measures are used where available:
+ * the bytes still queued in the tty (TIOCOUTQ), and how long the
+ * terminal takes to answer a cursor position report (CSI 6n), which
+ * also covers whatever sits between here and the terminal, like SSH.
+ */
+struct backlog {
+    struct clock *clock;
+    int fd_out;
+    int fd_in;
+    uint64_t budget;        /* Most latency allowed, in ns */
+    uint64_t dropped;       /* Frames left out so far */
+
+    int outq;               /* Whether the output queue can be measured */
+    long queued;            /* Bytes queued right after the last write */
+    uint64_t queued_at;
+    double drain_rate;      /* Bytes per ns, 0 if not known yet */
+
+    int dsr;                /* Whether position reports are used */
+    int dsr_answered;       /* Whether any report ever came back */
+    uint64_t dsr_sent;      /* When the outstanding request went out, or 0 */
+    uint64_t dsr_latency;   /* Round trip of the last answered request */
+    int dsr_state;          /* Progress through a CSI ... R reply */
+};
+
+void backlog_init(struct backlog *backlog, struct clock *clock, int fd_out, int fd_in,
+        uint64_t budget, int dsr);
+int backlog_congested(struct backlog *backlog);
+int backlog_probe(struct backlog *backlog);
+void backlog_sent(struct backlog *backlog, size_t bytes, int probed);
+void backlog_settle(struct backlog *backlog, uint64_t timeout);
+
+void pacer_start(struct pacer *pacer, struct clock *clock, uint64_t period);
+uint64_t pacer_wait(struct pacer *pacer);
+uint64_t pacer_elapsed(struct pacer *pacer);
+void pacer_report(FILE *out, const struct pacer *pacer);
+
+#endif
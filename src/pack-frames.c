@@ -0,0 +1,104 @@
+/*
+ * Build-time helper: packs the animation frames into the format
+ * render.c reads, and prints the result as C source.
+ *
+ * Each cell becomes a 4-bit index into the palette, two cells per
+ * byte (the left one in the low nibble). Most rows repeat between
+ * frames, so every distinct row is stored once, and frames are
+ * lists of row numbers.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "animation.c"
+
+#define PACKED_ROW (FRAME_WIDTH / 2)
+#define MAX_ROWS 65536
+
+static char palette[17];
+static unsigned char rows[MAX_ROWS][PACKED_ROW];
+static size_t row_count = 0;
+
+static int palette_index(char c) {
+    char *found = strchr(palette, c);
+    if (c && found) {
+        return found - palette;
+    }
+    if (strlen(palette) == 16) {
+        fprintf(stderr, "pack-frames: more than 16 colors in the animations\n");
+        exit(1);
+    }
+    palette[strlen(palette)] = c;
+    return strlen(palette) - 1;
+}
+
+/*
+ * Number of the packed row, adding it if it is new.
+ */
+static size_t row_index(const char *row) {
+    unsigned char packed[PACKED_ROW];
+    size_t k;
+    int x;
+
+    for (x = 0; x < FRAME_WIDTH; x += 2) {
+        packed[x / 2] = palette_index(row[x]) | palette_index(row[x + 1]) << 4;
+    }
+    for (k = 0; k < row_count; ++k) {
+        if (!memcmp(rows[k], packed, PACKED_ROW)) return k;
+    }
+    if (row_count == MAX_ROWS) {
+        fprintf(stderr, "pack-frames: too many distinct rows\n");
+        exit(1);
+    }
+    memcpy(rows[row_count], packed, PACKED_ROW);
+    return row_count++;
+}
+
+static void pack(const char *name, const char ***frames) {
+    size_t i, count = 0;
+    int y;
+
+    while (frames[count]) ++count;
+    printf("static const unsigned short %s_row_index[%zu] = {", name, count * FRAME_HEIGHT);
+    for (i = 0; i < count; ++i) {
+        printf("\n    /* frame %zu */", i);
+        for (y = 0; y < FRAME_HEIGHT; ++y) {
+            if (strlen(frames[i][y]) != FRAME_WIDTH) {
+                fprintf(stderr, "pack-frames: %s frame %zu row %d is not %d wide\n", name, i, y, FRAME_WIDTH);
+                exit(1);
+            }
+            printf("%s%zu,", y % 16 ? " " : "\n    ", row_index(frames[i][y]));
+        }
+    }
+    printf("\n};\n\n");
+    printf("static const struct packed_animation %s = {%zu, %s_row_index};\n\n", name, count, name);
+}
+
+int main(void) {
+    size_t k;
+    int x;
+
+    printf("/*\n * Generated by pack-frames from animation.c, do not edit.\n */\n\n");
+    pack("animation", frames);
+
+    printf("static const char animation_palette[16] = {");
+    for (k = 0; k < 16; ++k) {
+        printf(k ? ", %d" : "%d", palette[k]);
+    }
+    printf("};\n\n");
+
+    printf("static const unsigned char animation_rows[%zu][PACKED_ROW] = {\n", row_count);
+    for (k = 0; k < row_count; ++k) {
+        printf("    {");
+        for (x = 0; x < PACKED_ROW; ++x) {
+            printf(x ? ",0x%02x" : "0x%02x", rows[k][x]);
+        }
+        printf("},\n");
+    }
+    printf("};\n");
+    return 0;
+}
@@ -60,39 +60,22 @@
 #include <time.h>
 #include <setjmp.h>
 #include <getopt.h>
+#include <errno.h>
+#include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
 
-#include <sys/ioctl.h>
-
-#ifndef TIOCGWINSZ
 #include <termios.h>
-#endif
-
-#ifdef ECHO
-#undef ECHO
-#endif
-
-
-/*
- * The animation frames are stored separately in
- * this header so they don't clutter the core source
- */
-#include "animation_3.c"
-#include "animation_4.c"
-#include "animation_5.c"
-#include "animation_6.c"
 
-/*
- * Color palette to use for final output
- * Specifically, this should be either control sequences
- * or raw characters (ie, for vt220 mode)
- */
-const char *colors[256] = {NULL};
+#include <sys/ioctl.h>
+#include <sys/uio.h>
 
-/*
- * For most modes, we output spaces, but for some
- * we will use block characters (or even nothing)
- */
-const char *output = "  ";
+#include "render.h"
+#include "flags.h"
+#include "pacing.h"
+#include "ring.h"
+#include "terminal.h"
+#include "store.h"
 
 /*
  * Whether or not to show the counter
@@ -105,12 +88,6 @@ int show_counter = 1;
  */
 unsigned int frame_count = 0;
 
-/*
- * Clear the screen between frames (as opposed to resetting
- * the cursor position)
- */
-int clear_screen = 1;
-
 /*
  * Force-set the terminal title.
  */
@@ -137,15 +114,6 @@ int digits(int val) {
     return (c < 0) ? ++d : d;
 }
 
-/*
- * These values crop the animation, as we have a full 64x64 stored,
- * but we only want to display 40x24 (double width).
- */
-int min_row = -1;
-int max_row = -1;
-int min_col = -1;
-int max_col = -1;
-
 /*
  * Actual width/height of terminal.
  */
@@ -153,60 +121,571 @@ int terminal_width = 80;
 int terminal_height = 24;
 
 /*
- * Flags to keep track of whether width/height were automatically set.
+ * Flags to keep track of whether width/height were automatically set,
+ * and the sizes given with -W and -H otherwise.
  */
 char using_automatic_width = 0;
 char using_automatic_height = 0;
+int crop_width = 0;
+int crop_height = 0;
+
+/*
+ * Whether the animation is scaled to fit the terminal (-z fit).
+ */
+int scale_to_fit = 0;
+
+/*
+ * Viewport for the render thread to switch to, handed over by the
+ * event loop once a resize has settled. The render thread picks it
+ * up between frames and rebuilds the frame cache for it.
+ */
+struct viewport {
+    int min_row;
+    int max_row;
+    int min_col;
+    int max_col;
+    double scale;
+};
+pthread_mutex_t viewport_lock = PTHREAD_MUTEX_INITIALIZER;
+struct viewport next_viewport = {0, 0, 0, 0, 1.0};
+int viewport_changed = 1;
+
+/*
+ * The frames are first built for what $TERM suggests, while the
+ * terminal is still answering the queries. Frames are only handed
+ * to the writer once probing is cleared. If the answers call for a
+ * different color mode or run collapsing, they come with the next
+ * viewport as next_ttype and next_rle, with next_ttype -1 otherwise.
+ */
+const struct flag *palette_flag;
+int probing = 0;
+int next_ttype = -1;
+enum rle_mode next_rle;
+pthread_cond_t probe_answered = PTHREAD_COND_INITIALIZER;
+
+/*
+ * How long the terminal size has to stay put before the frames are
+ * rebuilt for it, and the longest a drag may hold that off.
+ */
+#define RESIZE_SETTLE_MS 50
+#define RESIZE_MAX_WAIT_MS 250
+
+/*
+ * Signal handlers only write the signal number down this pipe, the
+ * event loop in main() does the actual work. The writer thread sends
+ * a 0 once the last requested frame is out.
+ */
+int signal_pipe[2] = {-1, -1};
+
+/*
+ * Print how many bytes each kind of frame took on exit.
+ */
+int show_stats = 0;
+unsigned long long full_frames = 0, full_bytes = 0;
+unsigned long long delta_frames = 0, delta_bytes = 0;
+unsigned long long cache_builds = 0, cache_build_ns = 0;
+
+/*
+ * Keeps the frames on schedule and records how well it managed.
+ */
+struct pacer pacer;
+
+/*
+ * Keeps track of how far behind the terminal is.
+ */
+struct backlog backlog;
+
+/*
+ * Whether to ask the terminal what it supports, and its answers.
+ */
+int query_terminal = 0;
+struct terminal_caps caps;
+
+/*
+ * Whether frames are wrapped in synchronized output markers (DEC
+ * mode 2026), so the terminal shows each one only once it is all in.
+ */
+int sync_output = 0;
+
+/*
+ * Whether encoded frames are kept on disk for the next run (-c),
+ * where, and whether they are shared with other copies running at
+ * the same time (-m). Also how often they were found ready.
+ */
+int use_store = 0;
+char store_dir[4096];
+int use_shared = 0;
+unsigned long store_hits = 0, store_misses = 0;
+
+/*
+ * Whether frames go to a file or pipe instead of a terminal (-o),
+ * as fast as they can be written. The clock then only pretends to
+ * wait, so the counter still reads as if the frames were paced.
+ */
+int headless = 0;
+struct clock virtual_clock;
+
+/*
+ * Terminal settings to put back on exit, if they were changed.
+ */
+struct termios saved_termios;
+int restore_termios = 0;
+
+/*
+ * State shared between the render thread and the writer.
+ * writer_tick is the frame period the writer has got to.
+ */
+struct frame_ring ring;
+uint64_t writer_tick = 0;
+
+/*
+ * Report the bytes per frame sent in each render mode.
+ */
+void print_stats() {
+    fprintf(stderr, "full frames:  %llu, %llu bytes/frame\n",
+            full_frames, full_frames ? full_bytes / full_frames : 0);
+    fprintf(stderr, "delta frames: %llu, %llu bytes/frame\n",
+            delta_frames, delta_frames ? delta_bytes / delta_frames : 0);
+    fprintf(stderr, "all frames:   %llu, %llu bytes/frame\n", full_frames + delta_frames,
+            (full_frames + delta_frames) ? (full_bytes + delta_bytes) / (full_frames + delta_frames) : 0);
+    fprintf(stderr, "frame caches: %llu, %.3f ms/cache\n", cache_builds,
+            cache_builds ? cache_build_ns / 1e6 / cache_builds : 0.0);
+    pacer_report(stderr, &pacer);
+    fprintf(stderr, "dropped frames: %llu, %.3f ms last round trip\n",
+            (unsigned long long) backlog.dropped, backlog.dsr_latency / 1e6);
+    if (query_terminal) {
+        fprintf(stderr, "terminal: %s%s%s%s%s%s\n",
+                caps.answered ? (caps.version[0] ? caps.version : "answered") : "no answer",
+                caps.rep ? ", rep" : "", caps.sync ? ", sync" : "", caps.truecolor ? ", truecolor" : "",
+                caps.sixel ? ", sixel" : "", caps.kitty_graphics ? ", kitty graphics" : "");
+    }
+    if (use_store || use_shared) {
+        fprintf(stderr, "stored frames: %lu loaded, %lu built\n", store_hits, store_misses);
+    }
+}
 
 /*
  * Print escape sequences to return cursor to visible mode
  * and exit the application.
  */
 void finish() {
+    if (restore_termios) {
+        /* Swallow any position report still on its way, then discard leftover input */
+        backlog_settle(&backlog, 200000000u);
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_termios);
+    }
+    /* A frame cut short by ^C may have left the terminal holding back output */
+    if (sync_output) {
+        printf("\033[?2026l");
+    }
+    /* Both threads are done with the frames by now */
+    ring_free(&ring);
+    /* Leaving the alternate screen brings back what was there before */
     if (clear_screen) {
-        printf("\033[?25h\033[0m\033[H\033[2J");
+        printf("\033[0m\033[H\033[2J\033[?1049l\033[?25h");
     } else {
-        printf("\033[0m\n");
+        printf("\033[0m\033[?1049l");
+    }
+    if (show_stats) {
+        /* After the terminal is back on the normal screen, where they stay visible */
+        fflush(stdout);
+        print_stats();
     }
     exit(0);
 }
 
 /*
  * In the standalone mode, we want to handle an interrupt signal
- * (^C) so that we can restore the cursor and clear the terminal.
+ * (^C) so that we can restore the cursor and clear the terminal,
+ * and a resize so the animation can be cropped to fit. Neither can
+ * be dealt with safely in here, so just wake up the event loop.
  */
-void SIGINT_handler(int sig) {
-    (void) sig;
-    finish();
+void signal_handler(int sig) {
+    int saved_errno = errno;
+    unsigned char c = sig;
+    if (write(signal_pipe[1], &c, 1) < 0) {
+        /* The pipe is full, so the event loop has plenty to wake up for */
+    }
+    errno = saved_errno;
 }
 
+/*
+ * Work out the viewport for the terminal size: the scale, if the
+ * animation is fitted to the terminal, and which part of the scaled
+ * animation to show, centered. Sizes given with -W and -H are kept.
+ */
+void fit_viewport(struct viewport *v) {
+    int across = cells_across(terminal_width);
+    int down = cells_down(terminal_height - 1);
+
+    if (scale_to_fit && across > 0 && down > 0) {
+        double x = (double) across / FRAME_WIDTH, y = (double) down / FRAME_HEIGHT;
+        v->scale = x < y ? x : y;
+    }
+    int width = (int) (FRAME_WIDTH * v->scale + 0.5);
+    int height = (int) (FRAME_HEIGHT * v->scale + 0.5);
+
+    if (using_automatic_width) {
+        v->min_col = (width - across) / 2;
+        v->max_col = (width + across) / 2;
+    } else {
+        v->min_col = (width - crop_width) / 2;
+        v->max_col = (width + crop_width) / 2;
+    }
+
+    if (using_automatic_height) {
+        v->min_row = (height - down) / 2;
+        v->max_row = (height + down) / 2;
+    } else {
+        v->min_row = (height - crop_height) / 2;
+        v->max_row = (height + crop_height) / 2;
+    }
+}
 
-void SIGWINCH_handler(int sig) {
-    (void) sig;
+/*
+ * Query the terminal size and hand the viewport that
+ * goes with it over to the render thread.
+ */
+void resize_viewport() {
     struct winsize w;
     ioctl(0, TIOCGWINSZ, &w);
-    terminal_width = w.ws_col;
+    __atomic_store_n(&terminal_width, w.ws_col, __ATOMIC_RELAXED);
     terminal_height = w.ws_row;
 
-    if (using_automatic_width) {
-        min_col = (FRAME_WIDTH - terminal_width / 2) / 2;
-        max_col = (FRAME_WIDTH + terminal_width / 2) / 2;
+    pthread_mutex_lock(&viewport_lock);
+    fit_viewport(&next_viewport);
+    viewport_changed = 1;
+    pthread_mutex_unlock(&viewport_lock);
+}
+
+/*
+ * Send a set of buffers to the terminal, picking up
+ * where a short write left off.
+ */
+void write_all(struct iovec *iov, int count) {
+    while (count > 0) {
+        ssize_t n = writev(STDOUT_FILENO, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            exit(1);
+        }
+        while (count > 0 && (size_t) n >= iov->iov_len) {
+            n -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *) iov->iov_base + n;
+            iov->iov_len -= n;
+        }
     }
+}
 
-    if (using_automatic_height) {
-        min_row = (FRAME_HEIGHT - (terminal_height - 1)) / 2;
-        max_row = (FRAME_HEIGHT + (terminal_height - 1)) / 2;
+
+/*
+ * Send an encoded frame, either a full one or a delta, followed
+ * by the counter line if its text changed since the last full frame.
+ */
+void send_frame(const char *data, size_t len, int full) {
+    static char counter[256];
+    static char last_counter[256];
+    static size_t last_counter_len = 0;
+    static char position_request[] = "\033[6n";
+    static char sync_begin[] = "\033[?2026h";
+    static char sync_end[] = "\033[?2026l";
+
+    /* Send the pre-encoded frame and the counter in one go */
+    struct iovec iov[5];
+    int iovcnt = 0;
+    if (sync_output) {
+        iov[iovcnt].iov_base = sync_begin;
+        iov[iovcnt].iov_len = sizeof(sync_begin) - 1;
+        iovcnt++;
+    }
+    iov[iovcnt].iov_base = (char *) data;
+    iov[iovcnt].iov_len = len;
+    iovcnt++;
+    if (full) {
+        last_counter_len = 0;
+    }
+    if (show_counter) {
+        /* Get the current time for the "You have nyaned..." string */
+        double diff = pacer_elapsed(&pacer) / 1000000000u;
+        /* Now count the length of the time difference so we can center */
+        int nLen = digits((int) diff);
+        /*
+         * 29 = the length of the rest of the string;
+         * XXX: Replace this was actually checking the written bytes from a
+         * call to sprintf or something
+         */
+        int width = (__atomic_load_n(&terminal_width, __ATOMIC_RELAXED) - 29 - nLen) / 2;
+        if (width > (int) sizeof(counter) - 64) width = sizeof(counter) - 64;
+        if (width < 0) width = 0;
+        /* Spit out some spaces so that we're actually centered */
+        memset(counter, ' ', width);
+        /* You have nyaned for [n] seconds!
+         * The \033[J ensures that the rest of the line has the dark blue
+         * background, and the \033[1;37m ensures that our text is bright white.
+         * The \033[0m prevents the Apple ][ from flipping everything, but
+         * makes the whole nyancat less bright on the vt220
+         */
+        size_t counter_len = width + snprintf(counter + width, sizeof(counter) - width,
+                "\033[1;37mYou have prided for %0.0f seconds!\033[J\033[0m", diff);
+        /* The frames leave the counter line alone, so only send it when it changed */
+        if (counter_len != last_counter_len || memcmp(counter, last_counter, counter_len)) {
+            memcpy(last_counter, counter, counter_len);
+            last_counter_len = counter_len;
+            iov[iovcnt].iov_base = counter;
+            iov[iovcnt].iov_len = counter_len;
+            iovcnt++;
+        }
+    }
+    if (sync_output) {
+        iov[iovcnt].iov_base = sync_end;
+        iov[iovcnt].iov_len = sizeof(sync_end) - 1;
+        iovcnt++;
+    }
+    /* Ask where the cursor is, the answer tells when the terminal got this far */
+    int probe = backlog_probe(&backlog);
+    if (probe) {
+        iov[iovcnt].iov_base = position_request;
+        iov[iovcnt].iov_len = sizeof(position_request) - 1;
+        iovcnt++;
     }
 
-    signal(SIGWINCH, SIGWINCH_handler);
+    size_t sent = 0;
+    int k;
+    for (k = 0; k < iovcnt; ++k) {
+        sent += iov[k].iov_len;
+    }
+    write_all(iov, iovcnt);
+    backlog_sent(&backlog, sent, probe);
+    if (full) {
+        full_frames++;
+        full_bytes += sent;
+    } else {
+        delta_frames++;
+        delta_bytes += sent;
+    }
 }
 
-void newline(int n) {
-    for (int i = 0; i < n; ++i) {
-        putc('\n', stdout);
+/*
+ * Writer thread: sends each frame from the ring once it is due,
+ * dropping frames that are late or that the terminal has no room for.
+ *
+ * Dropped deltas are collected in pending, so later deltas still
+ * apply on top of them. If that ever grows past a full frame, the
+ * next full frame is sent instead.
+ */
+void *writer_main(void *arg) {
+    struct buffer pending = {0};
+    long screen = -1;           /* Frame shown once pending is sent, if known */
+    unsigned generation = 0;
+    uint64_t tick = 0;
+    unsigned int f = 0;         /* Total frames passed */
+    (void) arg;
+
+    for (;;) {
+        struct frame_slot *slot = NULL;
+        /* Once closed, frames still in the ring are not wanted anymore */
+        while (!ring_closed(&ring) && !(slot = ring_peek(&ring))) {
+            ring_wait(&ring, 0);
+        }
+        if (ring_closed(&ring)) break;
+        int chained = screen >= 0 && slot->generation == generation && slot->delta &&
+                slot->base == screen && pending.len + slot->delta < slot->full;
+        int late = slot->tick < tick;
+        if (late || backlog_congested(&backlog)) {
+            /* Leave this frame out, but keep track of what it changed */
+            if (chained) {
+                buffer_append(&pending, slot->data.data + slot->full, slot->delta);
+                screen = slot->frame;
+            } else {
+                pending.len = 0;
+                screen = -1;
+            }
+            generation = slot->generation;
+            ring_release(&ring);
+            if (late) {
+                /* Look for the frame that is actually due now */
+                continue;
+            }
+        } else {
+            if (chained) {
+                buffer_append(&pending, slot->data.data + slot->full, slot->delta);
+                send_frame(pending.data, pending.len, 0);
+            } else {
+                send_frame(slot->data.data, slot->full, 1);
+            }
+            pending.len = 0;
+            screen = slot->frame;
+            generation = slot->generation;
+            ring_release(&ring);
+            /* Update frame count */
+            ++f;
+            if (frame_count != 0 && f == frame_count) {
+                static const unsigned char done = 0;
+                ring_close(&ring);
+                if (write(signal_pipe[1], &done, 1) < 0) {
+                    /* The event loop still notices once the ring is closed */
+                }
+                break;
+            }
+        }
+        /* Wait, leaving out frames whose time has already passed */
+        tick += 1 + pacer_wait(&pacer);
+        __atomic_store_n(&writer_tick, tick, __ATOMIC_RELAXED);
+    }
+    buffer_free(&pending);
+    return NULL;
+}
+
+/*
+ * Fill a ring slot with frame i, as a whole and as the change
+ * from frame base if there is one.
+ */
+void encode_slot(struct frame_slot *slot, struct frame_cache *cache, long base, size_t i) {
+    const char *data;
+    size_t len;
+
+    slot->data.len = 0;
+    cache_lookup(cache, -1, i, &data, &len);
+    buffer_append(&slot->data, data, len);
+    slot->full = len;
+    slot->delta = 0;
+    if (!cache_lookup(cache, base, i, &data, &len)) {
+        buffer_append(&slot->data, data, len);
+        slot->delta = len;
+    }
+    slot->base = base;
+    slot->frame = i;
+}
+
+/*
+ * Render thread: keeps the ring filled with upcoming frames,
+ * switching to a new viewport between frames when it changes.
+ */
+void *render_main(void *arg) {
+    struct frame_cache cache = {0};
+    unsigned generation = 0;
+    uint64_t tick = 0;  /* Frame period being composed */
+    long composed = -1; /* Frame composed before it, if any */
+    int save = 0;       /* Frames built that are still to be stored */
+    (void) arg;
+
+    while (!ring_closed(&ring)) {
+        struct frame_slot *slot = ring_acquire(&ring);
+        if (!slot) {
+            ring_wait(&ring, 1);
+            continue;
+        }
+        pthread_mutex_lock(&viewport_lock);
+        int rebuild = viewport_changed;
+        if (rebuild) {
+            min_row = next_viewport.min_row;
+            max_row = next_viewport.max_row;
+            min_col = next_viewport.min_col;
+            max_col = next_viewport.max_col;
+            scale = next_viewport.scale;
+            viewport_changed = 0;
+            if (next_ttype >= 0) {
+                compile_palette(palette_flag, next_ttype);
+                rle_mode = next_rle;
+                next_ttype = -1;
+            }
+        }
+        pthread_mutex_unlock(&viewport_lock);
+        if (rebuild) {
+            uint64_t started = monotonic_clock.now(&monotonic_clock);
+            /* Frames another copy shared, then ones from an earlier run, or else new ones */
+            int shared = use_shared ? store_attach(&cache) : -1;
+            int found = shared == 0 || (use_store && store_load(&cache, store_dir) == 0);
+            if (!found) {
+                cache_build(&cache);
+                /* Frames lent for the last viewport are of no use now */
+                store_detach();
+            }
+            /* Built frames are stored, published or not, loaded ones already are */
+            save = use_store && !found;
+            /* This copy was the first to want these, so it shares them */
+            if (shared == 1) store_publish(&cache);
+            if (use_store || use_shared) {
+                if (found) {
+                    store_hits++;
+                } else {
+                    store_misses++;
+                }
+            }
+            cache_builds++;
+            cache_build_ns += monotonic_clock.now(&monotonic_clock) - started;
+            generation++;
+            composed = -1;
+        }
+        /* Wait for the answers, which may yet change what the frames should be */
+        if (__atomic_load_n(&probing, __ATOMIC_ACQUIRE)) {
+            pthread_mutex_lock(&viewport_lock);
+            while (probing) {
+                pthread_cond_wait(&probe_answered, &viewport_lock);
+            }
+            pthread_mutex_unlock(&viewport_lock);
+            continue;
+        }
+        /* If the writer skipped ahead, don't bother with frames it won't send */
+        uint64_t due = __atomic_load_n(&writer_tick, __ATOMIC_RELAXED);
+        if (due > tick) {
+            tick = due;
+        }
+        encode_slot(slot, &cache, composed, tick % cache.count);
+        slot->tick = tick;
+        slot->generation = generation;
+        ring_publish(&ring);
+        composed = slot->frame;
+        ++tick;
+        /* Writing them out can wait until the first frame is on its way */
+        if (save) {
+            store_save(&cache, store_dir);
+            save = 0;
+        }
     }
+    cache_free(&cache);
+    store_detach();
+    return NULL;
 }
 
+/*
+ * The terminal type to use, given the one $TERM suggests: what the
+ * terminal says about itself beats that.
+ */
+int answered_ttype(int ttype) {
+    if (caps.truecolor) {
+        return 0;
+    }
+    /* Anything recent enough to give its version does 256 colors */
+    if (caps.version[0] && ttype > 1) {
+        return 1;
+    }
+    return ttype;
+}
+
+/*
+ * How to collapse runs of one color on this terminal, by what it
+ * answered if it was asked, or else by $TERM and terminfo.
+ */
+enum rle_mode pick_rle(const char *term) {
+    /*
+     * Repeating the last character is shortest where supported.
+     * Erasing only leaves the flag colors behind on terminals that
+     * erase with the background color (bce), so anywhere that isn't
+     * known the spaces are sent as they are.
+     */
+    if (caps.rep || getenv("XTERM_VERSION") || (term && (strstr(term, "foot") || strstr(term, "kitty")))) {
+        return RLE_REP;
+    }
+    if (caps.bce || terminfo_bce(term)) {
+        return RLE_ECH;
+    }
+    return RLE_NONE;
+}
 
 /*
  * Print the usage / help text describing options
@@ -215,7 +694,9 @@ void usage(char *argv[]) {
     printf(
             "Terminal Nyancat with Pride Flags\n"
             "\n"
-            "usage: %s [-htnLGBTQPNA] [-f \033[3mframes\033[0m] [-p l|g|b|t|q|a|nb|p]\n"
+            "usage: %s [-htnqcmSLGBTQPNA] [-f \033[3mframes\033[0m] [-p l|g|b|t|q|a|nb|p] [-r full|delta]\n"
+            "       [-R none|ech|rep] [-g spaces|half|quadrant|sextant] [-z fit|\033[3mscale\033[0m] [-j \033[3mthreads\033[0m]\n"
+            "       [-F \033[3mfile\033[0m] [-o \033[3mcolumns\033[0mx\033[3mrows\033[0m] [-k \033[3mseed\033[0m]\n"
             "\n"
             " -L --lesbian    \033[3mShow the nyancat with lesbian flag\033[0m\n"
             " -G --gay    \033[3mShow the nyancat with the gay flag. \033[0m\n"
@@ -232,8 +713,21 @@ void usage(char *argv[]) {
             " -f --frames     \033[3mDisplay the requested number of frames, then quit\033[0m\n"
             " -W --width      \033[3mCrop the animation to the given width\033[0m\n"
             " -H --height     \033[3mCrop the animation to the given height\033[0m\n"
+            " -z --scale      \033[3mShow the animation bigger or smaller, or as big as fits the terminal (fit)\033[0m\n"
             " -h --help       \033[3mShow this help message.\033[0m\n"
-            " -p --pride      \033[3mSupports alternative spellings for pride flags.\033[0m\n\n"
+            " -p --pride      \033[3mSupports alternative spellings for pride flags.\033[0m\n"
+            " -r --render     \033[3mSend whole frames (full) or only what changed (delta, default)\033[0m\n"
+            " -R --rle        \033[3mCollapse runs of one color by erasing (ech) or repeating (rep), where known to work\033[0m\n"
+            " -g --glyphs     \033[3mDraw 2, 4 or 6 cells per character with half, quadrant or sextant blocks\033[0m\n"
+            " -j --threads    \033[3mEncode large terminals on this many threads (default one per processor)\033[0m\n"
+            " -l --latency    \033[3mDrop frames the terminal would show later than this many ms (0 never drops)\033[0m\n"
+            " -F --flags      \033[3mRead extra flags from a file (default ~/.config/pride-nyancat/flags)\033[0m\n"
+            " -o --headless   \033[3mWrite the frames for a terminal of this size (like 80x24) as fast as possible\033[0m\n"
+            " -k --seed       \033[3mSeed for the random choice of flag (default 0 with -o, else the time)\033[0m\n"
+            " -q --query      \033[3mAsk the terminal what it supports instead of going by $TERM alone\033[0m\n"
+            " -c --cache      \033[3mKeep the encoded frames in ~/.cache/pride-nyancat for the next run\033[0m\n"
+            " -m --shared     \033[3mShare the encoded frames with other copies running at the same time\033[0m\n"
+            " -S --stats      \033[3mPrint the bytes sent per frame on exit\033[0m\n\n"
             "Supported pride types are: \n"
             "                 lesbian (l)\n"
             "                 gay (g)\n"
@@ -251,15 +745,15 @@ int main(int argc, char **argv) {
     char *term = NULL;
     unsigned int k;
     int ttype;
+    int rle_auto = 1;
+    int threads = 0;                /* Encoding threads, 0 for one per processor */
+    int seed_given = 0;
+    enum flag_type flag = BUILTIN_FLAGS;   /* Random unless one is asked for */
+    unsigned int seed = time(NULL);
+    const char *pride = NULL;       /* Flag asked for by name */
+    const char *flags_file = NULL;  /* Extra flag definitions */
 
 
-    enum flag_type {
-        L=0, G=1, B=2, T=3, Q=4, NB=5, A=6, P=7
-    };
-
-    srand(time(NULL));
-    enum flag_type flag = rand()%8;
-
     /* Long option names */
     static struct option long_opts[] = {
             {"lesbian",     no_argument,       0, 'L'},
@@ -279,15 +773,31 @@ int main(int argc, char **argv) {
             {"width",       required_argument, 0, 'W'},
             {"height",      required_argument, 0, 'H'},
             {"pride",       required_argument, 0, 'p'},
+            {"render",      required_argument, 0, 'r'},
+            {"rle",         required_argument, 0, 'R'},
+            {"stats",       no_argument,       0, 'S'},
+            {"latency",     required_argument, 0, 'l'},
+            {"flags",       required_argument, 0, 'F'},
+            {"query",       no_argument,       0, 'q'},
+            {"glyphs",      required_argument, 0, 'g'},
+            {"scale",       required_argument, 0, 'z'},
+            {"threads",     required_argument, 0, 'j'},
+            {"cache",       no_argument,       0, 'c'},
+            {"shared",      no_argument,       0, 'm'},
+            {"headless",    required_argument, 0, 'o'},
+            {"seed",        required_argument, 0, 'k'},
             {0, 0,                             0, 0}
     };
 
     /* Time delay in milliseconds */
     int delay_ms = 90; // Default to original value
 
+    /* Most time a frame may spend waiting for the terminal, 0 for no limit */
+    int latency_ms = -1;
+
     /* Process arguments */
     int index, c;
-    while ((c = getopt_long(argc, argv, "LGBTQAPNeshnd:f:W:H:p:", long_opts, &index)) != -1) {
+    while ((c = getopt_long(argc, argv, "LGBTQAPNeshnqScmd:f:W:H:p:r:R:l:F:g:z:j:o:k:", long_opts, &index)) != -1) {
         if (!c) {
             if (long_opts[index].flag == 0) {
                 c = long_opts[index].val;
@@ -306,6 +816,70 @@ int main(int argc, char **argv) {
             case 'n':
                 show_counter = 0;
                 break;
+            case 'S':
+                show_stats = 1;
+                break;
+            case 'q':
+                query_terminal = 1;
+                break;
+            case 'c':
+                use_store = 1;
+                break;
+            case 'm':
+                use_shared = 1;
+                break;
+            case 'o':
+                if (sscanf(optarg, "%dx%d", &terminal_width, &terminal_height) != 2 ||
+                        terminal_width < 1 || terminal_height < 2) {
+                    printf("Headless size must be given as COLUMNSxROWS, not %s\n", optarg);
+                    exit(1);
+                }
+                headless = 1;
+                break;
+            case 'k':
+                seed = strtoul(optarg, NULL, 10);
+                seed_given = 1;
+                break;
+            case 'l':
+                latency_ms = atoi(optarg);
+                break;
+            case 'r':
+                if (strcmp(optarg, "full") == 0)
+                    render_mode = RENDER_FULL;
+                else if (strcmp(optarg, "delta") == 0)
+                    render_mode = RENDER_DELTA;
+                else {
+                    printf("Unrecognized render mode %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'R':
+                rle_auto = 0;
+                if (strcmp(optarg, "none") == 0)
+                    rle_mode = RLE_NONE;
+                else if (strcmp(optarg, "ech") == 0)
+                    rle_mode = RLE_ECH;
+                else if (strcmp(optarg, "rep") == 0)
+                    rle_mode = RLE_REP;
+                else {
+                    printf("Unrecognized run-length encoding %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'g':
+                if (strcmp(optarg, "spaces") == 0)
+                    glyph_mode = GLYPH_SPACES;
+                else if (strcmp(optarg, "half") == 0)
+                    glyph_mode = GLYPH_HALF;
+                else if (strcmp(optarg, "quadrant") == 0)
+                    glyph_mode = GLYPH_QUADRANT;
+                else if (strcmp(optarg, "sextant") == 0)
+                    glyph_mode = GLYPH_SEXTANT;
+                else {
+                    printf("Unrecognized glyph mode %s\n", optarg);
+                    exit(1);
+                }
+                break;
             case 'd':
                 if (10 <= atoi(optarg) && atoi(optarg) <= 1000)
                     delay_ms = atoi(optarg);
@@ -314,12 +888,27 @@ int main(int argc, char **argv) {
                 frame_count = atoi(optarg);
                 break;
             case 'W':
-                min_col = (FRAME_WIDTH - atoi(optarg)) / 2;
-                max_col = (FRAME_WIDTH + atoi(optarg)) / 2;
+                crop_width = atoi(optarg);
                 break;
             case 'H':
-                min_row = (FRAME_HEIGHT - atoi(optarg)) / 2;
-                max_row = (FRAME_HEIGHT + atoi(optarg)) / 2;
+                crop_height = atoi(optarg);
+                break;
+            case 'j':
+                threads = atoi(optarg);
+                if (threads < 1 || threads > MAX_ENCODE_THREADS) {
+                    printf("Thread count must be between 1 and %d\n", MAX_ENCODE_THREADS);
+                    exit(1);
+                }
+                break;
+            case 'z':
+                if (strcmp(optarg, "fit") == 0) {
+                    scale_to_fit = 1;
+                } else if (atof(optarg) >= 0.05 && atof(optarg) <= 64) {
+                    next_viewport.scale = atof(optarg);
+                } else {
+                    printf("Unrecognized scale %s\n", optarg);
+                    exit(1);
+                }
                 break;
             case 'L':
                 flag=L;
@@ -346,28 +935,11 @@ int main(int argc, char **argv) {
                 flag=NB;
                 break;
             case 'p':
-                if (strcmp(optarg, "lesbian") == 0 || strcmp(optarg, "l") == 0)
-                    flag = L;
-                else if (strcmp(optarg, "gay") == 0 || strcmp(optarg, "g") == 0)
-                    flag = G;
-                else if (strcmp(optarg, "bisexual") == 0 || strcmp(optarg, "bi") == 0 || strcmp(optarg, "b") == 0)
-                    flag = B;
-                else if (strcmp(optarg, "trans") == 0 || strcmp(optarg, "transgender") == 0 || strcmp(optarg, "t") == 0)
-                    flag = T;
-                else if (strcmp(optarg, "queer") == 0 || strcmp(optarg, "q") == 0)
-                    flag = Q;
-                else if (strcmp(optarg, "nonbinary") == 0 || strcmp(optarg, "non-binary") == 0 ||
-                         strcmp(optarg, "nb") == 0)
-                    flag = NB;
-                else if (strcmp(optarg, "asexual") == 0 || strcmp(optarg, "a") == 0 || strcmp(optarg, "ace") == 0)
-                    flag = A;
-                else if (strcmp(optarg, "pansexual") == 0 || strcmp(optarg, "pan-sexual") == 0 ||
-                         strcmp(optarg, "pan") == 0 || strcmp(optarg, "p") == 0)
-                    flag = P;
-                else {
-                    printf("Unrecognized pride type %s\n", optarg);
-                    exit(1);
-                }
+                /* Looked up once any extra flags are loaded */
+                pride = optarg;
+                break;
+            case 'F':
+                flags_file = optarg;
                 break;
             default:
                 exit(1);
@@ -375,13 +947,84 @@ int main(int argc, char **argv) {
     }
 
 
+    /* Without a terminal, the same options give the same frames every time */
+    if (headless && !seed_given) {
+        seed = 0;
+    }
+    srand(seed);
+    if (flag == BUILTIN_FLAGS) {
+        flag = rand() % BUILTIN_FLAGS;
+    }
+
+    /* Large viewports are encoded on every processor unless told otherwise */
+    if (!threads) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus < 1 ? 1 : cpus > MAX_ENCODE_THREADS ? MAX_ENCODE_THREADS : cpus;
+    }
+    encode_threads = threads;
+
+    if (use_store) {
+        const char *cache_home = getenv("XDG_CACHE_HOME");
+        if (cache_home && *cache_home) {
+            snprintf(store_dir, sizeof(store_dir), "%s/pride-nyancat", cache_home);
+        } else {
+            snprintf(store_dir, sizeof(store_dir), "%s/.cache/pride-nyancat", getenv("HOME") ? getenv("HOME") : "");
+        }
+    }
+
+    /* Extra flags come from -F, or else the user's config if it's there */
+    if (flags_file) {
+        if (load_flags(flags_file) < 0) {
+            perror(flags_file);
+            exit(1);
+        }
+    } else {
+        char path[4096];
+        const char *config = getenv("XDG_CONFIG_HOME");
+        if (config && *config) {
+            snprintf(path, sizeof(path), "%s/pride-nyancat/flags", config);
+        } else {
+            snprintf(path, sizeof(path), "%s/.config/pride-nyancat/flags", getenv("HOME") ? getenv("HOME") : "");
+        }
+        load_flags(path);
+    }
+
+    const struct flag *selected = &flag_table[flag];
+    if (pride) {
+        selected = find_flag(pride);
+        if (!selected) {
+            printf("Unrecognized pride type %s\n", pride);
+            exit(1);
+        }
+    }
+
+    /*
+     * Stop echoing keypresses over the animation, and let replies from
+     * the terminal come through without waiting for a newline.
+     */
+    int interactive = !headless && isatty(STDIN_FILENO) && isatty(STDOUT_FILENO);
+    if (interactive && tcgetattr(STDIN_FILENO, &saved_termios) == 0) {
+        struct termios raw = saved_termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        restore_termios = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+    }
+
+    /* Turn the flag into the rainbow cells */
+    char stripes[RAINBOW_ROWS + 3];
+    flag_rainbow(selected, stripes);
+    select_rainbow(stripes);
+
     term = getenv("TERM");
 
-    /* Also get the number of columns */
-    struct winsize w;
-    ioctl(0, TIOCGWINSZ, &w);
-    terminal_width = w.ws_col;
-    terminal_height = w.ws_row;
+    /* Also get the number of columns, unless there is no terminal to ask */
+    if (!headless) {
+        struct winsize w;
+        ioctl(0, TIOCGWINSZ, &w);
+        terminal_width = w.ws_col;
+        terminal_height = w.ws_row;
+    }
 
 
     /* Default ttype */
@@ -424,263 +1067,49 @@ int main(int argc, char **argv) {
             }
     }
 
-    int always_escape = 0; /* Used for text mode */
-
-    signal(SIGINT, SIGINT_handler);
-    signal(SIGWINCH,SIGWINCH_handler);
-
-    const char ***frames;
-    switch (flag) {
-        case G:
-            frames = frames_6; // 6 strips
-            break;
-
-        case L:
-        case T:
-            frames = frames_5; // 5 strips
-            break;
-
-        case P:
-        case B:
-        case Q:
-            frames = frames_3; // 3 strips
-            break;
-
-        case A:
-        case NB:
-            frames = frames_4;
-            break;
+    /* Until the terminal answers, if it is asked, go by $TERM */
+    if (rle_auto) {
+        rle_mode = pick_rle(term);
     }
-
-
-    switch (ttype) {
-        case 0:
-            colors[','] = "\033[48;2;9;22;128m";  /* Blue background */
-            colors['.'] = "\033[48;2;255;255;255m"; /* White stars */
-            colors['\''] = "\033[48;2;0;0;0m";  /* Black border */
-            colors['@'] = "\033[48;2;248;206;160m"; /* Tan poptart */
-            colors['$'] = "\033[48;2;242;160;250m"; /* Pink poptart */
-            colors['-'] = "\033[48;2;236;74;151m"; /* Red poptart */
-            colors['*'] = "\033[48;2;154;154;154m"; /* Gray cat face */
-            colors['%'] = "\033[48;2;242;158;156m"; /* Pink cheeks */
-            break;
-        case 1:
-            colors[','] = "\033[48;5;18m";  /* Blue background */
-            colors['.'] = "\033[48;5;231m"; /* White stars */
-            colors['\''] = "\033[48;5;16m";  /* Black border */
-            colors['@'] = "\033[48;5;223m"; /* Tan poptart */
-            colors['$'] = "\033[48;5;219m"; /* Pink poptart */
-            colors['-'] = "\033[48;5;204m"; /* Red poptart */
-            colors['*'] = "\033[48;5;102m"; /* Gray cat face */
-            colors['%'] = "\033[48;5;217m"; /* Pink cheeks */
-            break;
-        case 2:
-            colors[','] = "\033[104m";      /* Blue background */
-            colors['.'] = "\033[107m";      /* White stars */
-            colors['\''] = "\033[40m";       /* Black border */
-            colors['@'] = "\033[47m";       /* Tan poptart */
-            colors['$'] = "\033[105m";      /* Pink poptart */
-            colors['-'] = "\033[101m";      /* Red poptart */
-            colors['*'] = "\033[100m";      /* Gray cat face */
-            colors['%'] = "\033[105m";      /* Pink cheeks */
-            break;
-        default:
-            printf("Unsupported terminal. Please use an xterm compatible terminal.\n");
-            return 1;
-    }
-
-    switch (flag) {
-        case L:
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;198;59;30m";
-                    colors['&'] = "\033[48;2;243;160;99m";
-                    colors['+'] = "\033[48;2;255;255;255m";
-                    colors['#'] = "\033[48;2;199;106;163m";
-                    colors['='] = "\033[48;2;152;31;96m";
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;166m";
-                    colors['&'] = "\033[48;5;215m";
-                    colors['+'] = "\033[48;5;231m";
-                    colors['#'] = "\033[48;5;169m";
-                    colors['='] = "\033[48;5;89m";
-                    break;
-                case 2:
-                    // 16 color approximation doesn't work on this
-                    printf("Unsupported terminal. Please use an xterm compatible terminal.\n");
-                    return 1;
-                    break;
-            }
-            break;
-        case G:
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;236;51;44m"; /* Red  */
-                    colors['&'] = "\033[48;2;244;168;74m"; /* Orange  */
-                    colors['+'] = "\033[48;2;255;254;104m"; /* Yellow  */
-                    colors['#'] = "\033[48;2;53;126;43m"; /* Green  */
-                    colors['='] = "\033[48;2;0;28;239m";  /* Light blue  */
-                    colors[';'] = "\033[48;2;123;26;121m";  /* Purple  */
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;202m"; /* Red  */
-                    colors['&'] = "\033[48;5;215m"; /* Orange  */
-                    colors['+'] = "\033[48;5;227m"; /* Yellow  */
-                    colors['#'] = "\033[48;5;64m"; /* Green  */
-                    colors['='] = "\033[48;5;21m";  /* Light blue  */
-                    colors[';'] = "\033[48;5;90m";  /* Purple  */
-                    break;
-                case 2:
-                    colors['>'] = "\033[101m";      /* Red  */
-                    colors['&'] = "\033[43m";       /* Orange  */
-                    colors['+'] = "\033[103m";      /* Yellow  */
-                    colors['#'] = "\033[102m";      /* Green  */
-                    colors['='] = "\033[104m";      /* Light blue  */
-                    colors[';'] = "\033[45m";       /* Dark blue  */
-                    break;
-            }
-            break;
-        case T: /*5 strips, > & + # =, */
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;120;205;246m"; /* blue */
-                    colors['&'] = "\033[48;2;235;174;186m"; /* pink */
-                    colors['+'] = "\033[48;2;255;255;255m"; /* white */
-                    colors['#'] = "\033[48;2;235;174;186m"; /* pink */
-                    colors['='] = "\033[48;2;120;205;246m";  /* blue */
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;117m"; /* blue */
-                    colors['&'] = "\033[48;5;217m"; /* pink */
-                    colors['+'] = "\033[48;5;231m"; /* white */
-                    colors['#'] = "\033[48;5;217m"; /* pink */
-                    colors['='] = "\033[48;5;117m";  /* blue */
-                    break;
-                case 2:
-                    colors['>'] = "\033[106m";      /* blue */
-                    colors['&'] = "\033[105m";       /* pink */
-                    colors['+'] = "\033[107m";      /* white */
-                    colors['#'] = "\033[105m";      /* pink */
-                    colors['='] = "\033[106m";      /* blue */
-                    break;
-            }
-            break;
-        case B:
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;199;43;112m";
-                    colors['+'] = "\033[48;2;147;84;148m";
-                    colors['='] = "\033[48;2;14;56;163m";
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;161m";
-                    colors['+'] = "\033[48;5;96m";
-                    colors['='] = "\033[48;5;25m";
-                    break;
-                case 2:
-                    colors['>'] = "\033[41m";
-                    colors['+'] = "\033[45m";
-                    colors['='] = "\033[104m";
-                    break;
-            }
-            break;
-        case Q:
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;175;131;215m";
-                    colors['+'] = "\033[48;2;255;255;255m";
-                    colors['='] = "\033[48;2;86;128;48m";
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;140m";
-                    colors['+'] = "\033[48;5;231m";
-                    colors['='] = "\033[48;5;65m";
-                    break;
-                case 2:
-                    colors['>'] = "\033[105m";
-                    colors['+'] = "\033[107m";
-                    colors['='] = "\033[102m";
-                    break;
-            }
-            break;
-        case NB:
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;254;243;93m";
-                    colors['+'] = "\033[48;2;255;255;255m";
-                    colors['#'] = "\033[48;2;147;95;203m";
-                    colors[';'] = "\033[48;2;0;0;0m";
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;227m";
-                    colors['+'] = "\033[48;5;231m";
-                    colors['#'] = "\033[48;5;98m";
-                    colors[';'] = "\033[48;5;16m";
-                    break;
-                case 2:
-                    colors['>'] = "\033[103m";
-                    colors['+'] = "\033[107m";
-                    colors['#'] = "\033[45m";
-                    colors[';'] = "\033[40m";
-                    break;
-            }
-            break;
-        case A:
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;0;0;0m";
-                    colors['+'] = "\033[48;2;164;164;164m";
-                    colors['#'] = "\033[48;2;255;255;255m";
-                    colors[';'] = "\033[48;2;119;25;125m";
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;16m";
-                    colors['+'] = "\033[48;5;145m";
-                    colors['#'] = "\033[48;5;231m";
-                    colors[';'] = "\033[48;5;90m";
-                    break;
-                case 2:
-                    colors['>'] = "\033[40m";
-                    colors['+'] = "\033[47m";
-                    colors['#'] = "\033[107m";
-                    colors[';'] = "\033[45m";
-                    break;
-            }
-            break;
-        case P:
-            switch (ttype) {
-                case 0:
-                    colors['>'] = "\033[48;2;236;61;140m";
-                    colors['+'] = "\033[48;2;250;217;74m";
-                    colors['='] = "\033[48;2;80;177;249m";
-                    break;
-                case 1:
-                    colors['>'] = "\033[48;5;204m";
-                    colors['+'] = "\033[48;5;221m";
-                    colors['='] = "\033[48;5;75m";
-                    break;
-                case 2:
-                    colors['>'] = "\033[105m";
-                    colors['+'] = "\033[103m";
-                    colors['='] = "\033[107m";
-                    break;
-            }
-            break;
+    if (term && (strstr(term, "foot") || strstr(term, "kitty") || strstr(term, "wezterm") ||
+            strstr(term, "contour") || strstr(term, "ghostty"))) {
+        sync_output = 1;
     }
 
-    if (min_col == max_col) {
-        min_col = (FRAME_WIDTH - terminal_width / 2) / 2;
-        max_col = (FRAME_WIDTH + terminal_width / 2) / 2;
-        using_automatic_width = 1;
+    /* Signals are picked up by the event loop at the end of main() */
+    if (pipe(signal_pipe) < 0) {
+        perror("pipe");
+        return 1;
+    }
+    for (k = 0; k < 2; ++k) {
+        fcntl(signal_pipe[k], F_SETFL, fcntl(signal_pipe[k], F_GETFL) | O_NONBLOCK);
+        fcntl(signal_pipe[k], F_SETFD, FD_CLOEXEC);
+    }
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    if (!headless) {
+        sigaction(SIGWINCH, &action, NULL);
     }
 
-    if (min_row == max_row) {
-        min_row = (FRAME_HEIGHT - (terminal_height - 1)) / 2;
-        max_row = (FRAME_HEIGHT + (terminal_height - 1)) / 2;
-        using_automatic_height = 1;
+    /* The escapes for every cell depend on what the terminal seems to be */
+    palette_flag = selected;
+    if (compile_palette(selected, ttype) < 0) {
+        if (restore_termios) {
+            tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_termios);
+        }
+        printf("Unsupported terminal. Please use an xterm compatible terminal.\n");
+        return 1;
     }
 
+    using_automatic_width = crop_width == 0;
+    using_automatic_height = crop_height == 0;
+    fit_viewport(&next_viewport);
+
     /* Attempt to set terminal title */
     if (set_title) {
         printf("\033kNyanyanyanyanyanyanya...\033\134");
@@ -688,130 +1117,159 @@ int main(int argc, char **argv) {
         printf("\033]2;Nyanyanyanyanyanyanya...\007");
     }
 
+    /* Draw on the alternate screen, so nothing ends up in the scrollback */
     if (clear_screen) {
         /* Clear the screen */
-        printf("\033[H\033[2J\033[?25l");
+        printf("\033[?1049h\033[H\033[2J\033[?25l");
     } else {
-        printf("\033[s");
+        printf("\033[?1049h\033[s");
     }
 
-    /* Store the start time */
-    time_t start, current;
-    time(&start);
+    /*
+     * The terminal's replies take a round trip, so send the queries
+     * now, on the alternate screen where the replies of terminals that
+     * echo what they don't understand end up out of sight, and build
+     * the frames in the meantime.
+     */
+    uint64_t query_deadline = 0;
+    if (query_terminal && restore_termios) {
+        fflush(stdout);
+        terminal_query(STDOUT_FILENO);
+        query_deadline = monotonic_clock.now(&monotonic_clock) + QUERY_TIMEOUT_MS * 1000000ull;
+        probing = 1;
+    }
 
-    size_t i = 0;       /* Current frame # */
-    unsigned int f = 0; /* Total frames passed */
-    char last = 0;      /* Last color index rendered */
-    int y, x;        /* x/y coordinates of what we're drawing */
-    for (;;) {
-        /* Reset cursor */
-        if (clear_screen) {
-            printf("\033[H");
-        } else {
-            printf("\033[u");
+    /* By default, allow the terminal to fall two frames behind, files never do */
+    if (headless) {
+        latency_ms = 0;
+    } else if (latency_ms < 0) {
+        latency_ms = 2 * delay_ms;
+    }
+
+    /* Frames are paced by this clock, one that only pretends to wait without a terminal */
+    struct clock *clock = &monotonic_clock;
+    if (headless) {
+        virtual_clock_init(&virtual_clock, 0);
+        clock = &virtual_clock;
+    }
+    /*
+     * Deltas use absolute cursor positions, which only
+     * line up with the frame when it starts at the top.
+     */
+    if (!clear_screen) {
+        render_mode = RENDER_FULL;
+    }
+
+    backlog_init(&backlog, clock, STDOUT_FILENO, STDIN_FILENO,
+            latency_ms * 1000000ull, restore_termios);
+
+    /* Anything printed so far has to reach the terminal before the frames */
+    fflush(stdout);
+
+    /*
+     * Frames are composed on a render thread and sent from a writer
+     * thread, so a slow terminal doesn't hold up the next frame and
+     * vice versa. This thread is left to handle signals.
+     */
+    sigset_t signals, saved_signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGWINCH);
+    pthread_sigmask(SIG_BLOCK, &signals, &saved_signals);
+    pthread_t writer, renderer;
+    ring_init(&ring);
+    if (pthread_create(&renderer, NULL, render_main, NULL) != 0) {
+        perror("pthread_create");
+        return 1;
+    }
+
+    /* Meanwhile, see what the terminal said, and switch to that if it differs */
+    if (query_deadline) {
+        terminal_read_caps(&caps, STDIN_FILENO, &monotonic_clock, query_deadline);
+        int answered = answered_ttype(ttype);
+        enum rle_mode rle = rle_auto ? pick_rle(term) : rle_mode;
+        /* Terminals that were asked say whether they synchronize output */
+        sync_output = caps.sync;
+        pthread_mutex_lock(&viewport_lock);
+        if (answered != ttype || rle != rle_mode) {
+            next_ttype = answered;
+            next_rle = rle;
+            viewport_changed = 1;
         }
-        /* Render the frame */
-        for (y = min_row; y < max_row; ++y) {
-            for (x = min_col; x < max_col; ++x) {
-                char color;
-                if (y > 23 && y < 43 && x < 0) {
-                    /*
-                     * Generate the rainbow tail.
-                     *
-                     * This is done with a pretty simplistic square wave.
-                     */
-                    int mod_x = ((-x + 2) % 16) / 8;
-                    if ((i / 2) % 2) {
-                        mod_x = 1 - mod_x;
-                    }
-                    const char *rainbow;
-                    switch (flag) {
-                        case G:
-                            rainbow = ",,>>&&&+++###==;;;,,"; // 6 strips
-                            break;
-
-                        case L:
-                        case T:
-                            rainbow = ",,>>&&&+++###==,,,,,"; // 5 strips
-                            break;
-
-                        case P:
-                        case B:
-                        case Q:
-                            rainbow = ",,>>>>>++++++=====,,"; // 3 strips
-                            break;
-
-                        case A:
-                        case NB:
-                            rainbow = ",,>>>>++++####;;;;,,"; // 4 strips
-                            break;
-                    }
-
-                    color = rainbow[mod_x + y - 23];
-                    if (color == 0) color = ',';
-                } else if (x < 0 || y < 0 || y >= FRAME_HEIGHT || x >= FRAME_WIDTH) {
-                    /* Fill all other areas with background */
-                    color = ',';
-                } else {
-                    /* Otherwise, get the color from the animation frame. */
-                    color = frames[i][y][x];
-                }
-                if (always_escape) {
-                    /* Text mode (or "Always Send Color Escapes") */
-                    printf("%s", colors[(int) color]);
-                } else {
-                    if (color != last && colors[(int) color]) {
-                        /* Normal Mode, send escape (because the color changed) */
-                        last = color;
-                        printf("%s%s", colors[(int) color], output);
-                    } else {
-                        /* Same color, just send the output characters */
-                        printf("%s", output);
-                    }
-                }
+        probing = 0;
+        pthread_cond_broadcast(&probe_answered);
+        pthread_mutex_unlock(&viewport_lock);
+    }
+
+    /* Frames are due at multiples of the delay from now on */
+    pacer_start(&pacer, clock, delay_ms * 1000000ull);
+    if (pthread_create(&writer, NULL, writer_main, NULL) != 0) {
+        perror("pthread_create");
+        return 1;
+    }
+    pthread_sigmask(SIG_SETMASK, &saved_signals, NULL);
+
+    /*
+     * Event loop: wait for signals, and apply resizes once the size
+     * has settled, so dragging a window doesn't rebuild every frame
+     * for every size it passes through.
+     */
+    int interrupted = 0;
+    uint64_t resize_first = 0, resize_last = 0;
+    while (!ring_closed(&ring)) {
+        int timeout = -1;
+        uint64_t now = monotonic_clock.now(&monotonic_clock);
+        if (resize_last) {
+            uint64_t due = resize_last + RESIZE_SETTLE_MS * 1000000ull;
+            if (due > resize_first + RESIZE_MAX_WAIT_MS * 1000000ull) {
+                due = resize_first + RESIZE_MAX_WAIT_MS * 1000000ull;
             }
-            /* End of row, send newline */
-            newline(1);
-        }
-        if (show_counter) {
-            /* Get the current time for the "You have nyaned..." string */
-            time(&current);
-            double diff = difftime(current, start);
-            /* Now count the length of the time difference so we can center */
-            int nLen = digits((int) diff);
-            /*
-             * 29 = the length of the rest of the string;
-             * XXX: Replace this was actually checking the written bytes from a
-             * call to sprintf or something
-             */
-            int width = (terminal_width - 29 - nLen) / 2;
-            /* Spit out some spaces so that we're actually centered */
-            while (width > 0) {
-                printf(" ");
-                width--;
+            if (now >= due) {
+                resize_viewport();
+                resize_first = resize_last = 0;
+                continue;
             }
-            /* You have nyaned for [n] seconds!
-             * The \033[J ensures that the rest of the line has the dark blue
-             * background, and the \033[1;37m ensures that our text is bright white.
-             * The \033[0m prevents the Apple ][ from flipping everything, but
-             * makes the whole nyancat less bright on the vt220
-             */
-            printf("\033[1;37mYou have prided for %0.0f seconds!\033[J\033[0m", diff);
+            timeout = (due - now) / 1000000u + 1;
         }
-        /* Reset the last color so that the escape sequences rewrite */
-        last = 0;
-        /* Update frame count */
-        ++f;
-        if (frame_count != 0 && f == frame_count) {
-            finish();
-            return 0;
+        struct pollfd pfd = {signal_pipe[0], POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0 && errno != EINTR) {
+            break;
         }
-        ++i;
-        if (!frames[i]) {
-            /* Loop animation */
-            i = 0;
+        if (ready <= 0) {
+            continue;
+        }
+        unsigned char received[64];
+        ssize_t n = read(signal_pipe[0], received, sizeof(received)), r;
+        now = monotonic_clock.now(&monotonic_clock);
+        for (r = 0; r < n; ++r) {
+            switch (received[r]) {
+                case SIGWINCH:
+                    if (!resize_first) resize_first = now;
+                    resize_last = now;
+                    break;
+                case SIGINT:
+                case SIGTERM:
+                    interrupted = 1;
+                    break;
+            }
+        }
+        if (interrupted) {
+            break;
         }
-        /* Wait */
-        usleep(1000 * delay_ms);
     }
+
+    if (interrupted) {
+        /* Throw away frames still queued for the terminal, so we stop right away */
+        tcflush(STDOUT_FILENO, TCOFLUSH);
+    }
+    ring_close(&ring);
+    pthread_join(renderer, NULL);
+    pthread_join(writer, NULL);
+    if (interrupted) {
+        tcflush(STDOUT_FILENO, TCOFLUSH);
+    }
+    finish();
+    return 0;
 }
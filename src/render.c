@@ -0,0 +1,1422 @@
+/*
+ * Frame composition and encoding for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "render.h"
+#include "scan.h"
+
+/*
+ * The animation frames are stored separately in
+ * animation.c so they don't clutter the core source,
+ * and packed into this one at build time.
+ */
+#include "animation_packed.c"
+
+/*
+ * Color palette to use for final output
+ * Specifically, this should be either control sequences
+ * or raw characters (ie, for vt220 mode)
+ */
+const char *colors[256] = {NULL};
+
+/*
+ * The same colors as foreground, for the glyph modes.
+ */
+const char *fg_colors[256] = {NULL};
+
+/*
+ * For most modes, we output spaces, but for some
+ * we will use block characters (or even nothing)
+ */
+const char *output = "  ";
+
+/*
+ * Clear the screen between frames (as opposed to resetting
+ * the cursor position)
+ */
+int clear_screen = 1;
+
+/*
+ * The animation frames.
+ */
+const struct packed_animation *frames = &animation;
+
+/*
+ * The color index for every 4-bit cell of each frame row, with the
+ * rainbow cells of that row in the current flag's colors.
+ */
+static char row_palette[FRAME_HEIGHT][16];
+
+/*
+ * Whether to send whole frames or only what changed.
+ */
+enum render_mode render_mode = RENDER_DELTA;
+
+/*
+ * How runs of cells in the same color are collapsed, if at all.
+ */
+enum rle_mode rle_mode = RLE_NONE;
+
+/*
+ * How many cells go into each character cell of the terminal.
+ */
+enum glyph_mode glyph_mode = GLYPH_SPACES;
+
+static const struct {
+    int across;     /* Cells side by side in a character cell */
+    int down;       /* Cells above each other */
+} glyph_shapes[] = {
+    [GLYPH_SPACES] = {1, 1},
+    [GLYPH_HALF] = {1, 2},
+    [GLYPH_QUADRANT] = {2, 2},
+    [GLYPH_SEXTANT] = {2, 3},
+};
+
+/*
+ * These values crop the animation, as we have a full 64x64 stored,
+ * but we only want to display 40x24 (double width).
+ */
+int min_row = -1;
+int max_row = -1;
+int min_col = -1;
+int max_col = -1;
+
+/*
+ * Make room for at least len more bytes.
+ */
+void buffer_reserve(struct buffer *buf, size_t len) {
+    if (buf->len + len > buf->size) {
+        size_t size = buf->size ? buf->size : 4096;
+        while (buf->len + len > size) size *= 2;
+        char *grown = realloc(buf->data, size);
+        if (!grown) {
+            perror("realloc");
+            exit(1);
+        }
+        buf->data = grown;
+        buf->size = size;
+    }
+}
+
+void buffer_append(struct buffer *buf, const char *data, size_t len) {
+    /* Nothing to copy, and data may be NULL for an empty viewport */
+    if (!len) return;
+    buffer_reserve(buf, len);
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+}
+
+void buffer_append_str(struct buffer *buf, const char *str) {
+    buffer_append(buf, str, strlen(str));
+}
+
+void buffer_free(struct buffer *buf) {
+    free(buf->data);
+    buf->data = NULL;
+    buf->len = buf->size = 0;
+}
+
+/*
+ * The rainbow tail runs along rows TAIL_TOP up to TAIL_TOP + TAIL_ROWS
+ * left of the frame, as a square wave 16 cells long that flips phase
+ * every other frame. Each row of it, read top to bottom, picks cells
+ * from the flag's rainbow, and so do the rainbow cells inside the
+ * frame. The rainbow starts on the row above TAIL_TOP.
+ */
+#define TAIL_TOP    24
+#define TAIL_ROWS   19
+#define TAIL_PERIOD 16
+
+static char rainbow[64];
+
+/*
+ * The tail worked out for the current flag in both phases. Cell x
+ * (x < 0) of a tail row is at index x mod TAIL_SPAN, so any stretch of
+ * the tail up to TAIL_SPAN cells long is a single copy.
+ */
+#define TAIL_SPAN (16 * TAIL_PERIOD)
+
+static char tail[2][TAIL_ROWS][TAIL_SPAN];
+
+/*
+ * Cell n of the rainbow, counted from the top of the row before
+ * TAIL_TOP. Beyond either end is background.
+ */
+static char rainbow_color(int n) {
+    if (n < 0 || n >= (int) strlen(rainbow)) {
+        return ',';
+    }
+    return rainbow[n];
+}
+
+/*
+ * Which color indices the current flag's animation uses at all.
+ */
+static char used[256];
+
+static void find_used(void) {
+    size_t k;
+    memset(used, 0, sizeof(used));
+    used[','] = 1;
+    for (k = 0; rainbow[k]; ++k) {
+        used[(unsigned char) rainbow[k]] = 1;
+    }
+    for (k = 0; k < frames->count * FRAME_HEIGHT; ++k) {
+        const unsigned char *packed = animation_rows[frames->rows[k]];
+        const char *palette = row_palette[k % FRAME_HEIGHT];
+        int x;
+        for (x = 0; x < PACKED_ROW; ++x) {
+            used[(unsigned char) palette[packed[x] & 15]] = 1;
+            used[(unsigned char) palette[packed[x] >> 4]] = 1;
+        }
+    }
+}
+
+static void build_tail(void) {
+    int phase, row, j;
+    for (phase = 0; phase < 2; ++phase) {
+        for (row = 0; row < TAIL_ROWS; ++row) {
+            for (j = 0; j < TAIL_SPAN; ++j) {
+                int x = j - TAIL_SPAN;
+                int mod_x = ((-x + 2) % TAIL_PERIOD) / (TAIL_PERIOD / 2);
+                if (phase) {
+                    mod_x = 1 - mod_x;
+                }
+                tail[phase][row][j] = rainbow_color(mod_x + row + TAIL_TOP - 23);
+            }
+        }
+    }
+}
+
+/*
+ * Color the animation in with a flag's rainbow, as laid out by
+ * flag_rainbow(): work out the tail, and which stripe each rainbow
+ * cell of the frames gets. Those are marked '0' or '1' in animation.c,
+ * for rainbow cell y - 23 or y - 22 on row y.
+ */
+void select_rainbow(const char *stripes) {
+    int y, k;
+    snprintf(rainbow, sizeof(rainbow), "%s", stripes);
+    for (y = 0; y < FRAME_HEIGHT; ++y) {
+        for (k = 0; k < 16; ++k) {
+            char c = animation_palette[k];
+            if (c == '0' || c == '1') {
+                c = rainbow_color(y - 23 + (c - '0'));
+            }
+            row_palette[y][k] = c;
+        }
+    }
+    build_tail();
+    find_used();
+}
+
+size_t frames_length(void) {
+    return frames->count;
+}
+
+/*
+ * How many cells of the animation fit into a number of terminal
+ * columns, and into a number of terminal rows.
+ */
+int cells_across(int columns) {
+    if (glyph_mode == GLYPH_SPACES) return columns / 2;
+    return columns * glyph_shapes[glyph_mode].across;
+}
+
+int cells_down(int rows) {
+    return rows * glyph_shapes[glyph_mode].down;
+}
+
+/*
+ * Compose cells from up to to of row y of frame i of the animation,
+ * into one color index per cell.
+ *
+ * The row is copied together from three parts: the tail (or just
+ * background) left of the frame, the frame itself, and background
+ * to the right of it.
+ */
+static void compose_span(char *cells, size_t i, int y, int from, int to) {
+    int x = from;       /* x coordinate of what we're drawing */
+    int end;
+
+    /* Left of the frame */
+    end = to < 0 ? to : 0;
+    if (x < end) {
+        if (y >= TAIL_TOP && y < TAIL_TOP + TAIL_ROWS) {
+            const char *strip = tail[(i / 2) % 2][y - TAIL_TOP];
+            while (x < end) {
+                int j = (x % TAIL_SPAN + TAIL_SPAN) % TAIL_SPAN;
+                int n = end - x < TAIL_SPAN - j ? end - x : TAIL_SPAN - j;
+                memcpy(cells, strip + j, n);
+                cells += n;
+                x += n;
+            }
+        } else {
+            memset(cells, ',', end - x);
+            cells += end - x;
+            x = end;
+        }
+    }
+
+    /* The frame itself */
+    end = to < FRAME_WIDTH ? to : FRAME_WIDTH;
+    if (x < end) {
+        if (y >= 0 && y < FRAME_HEIGHT) {
+            const unsigned char *packed = animation_rows[frames->rows[i * FRAME_HEIGHT + y]];
+            const char *palette = row_palette[y];
+            /* Unpack two cells per byte, after lining up on an even x */
+            if (x & 1) {
+                *cells++ = palette[packed[x / 2] >> 4];
+                ++x;
+            }
+            for (; x + 1 < end; x += 2) {
+                unsigned char pair = packed[x / 2];
+                char left = palette[pair & 15], right = palette[pair >> 4];
+                cells[0] = left;
+                cells[1] = right;
+                cells += 2;
+            }
+            if (x < end) {
+                *cells++ = palette[packed[x / 2] & 15];
+                ++x;
+            }
+        } else {
+            memset(cells, ',', end - x);
+            cells += end - x;
+            x = end;
+        }
+    }
+
+    /* Right of the frame */
+    if (x < to) {
+        memset(cells, ',', to - x);
+    }
+}
+
+/*
+ * Where each cell of the viewport is taken from when the animation
+ * is scaled, worked out once per viewport by sampling_setup().
+ * Column x of the viewport comes from cells col_lo[x] up to
+ * col_hi[x] of the composed rows, which start at cell src_from of
+ * the animation. Each viewport row is taken from up to most of them.
+ */
+static struct {
+    int *col_lo;
+    int *col_hi;
+    int src_from;
+    int src_width;
+    int most;
+} sampling;
+
+/*
+ * What compose_row() works in when scaling: the composed rows a
+ * viewport row is taken from, and how often each color came up in
+ * them. Every thread composing needs its own.
+ */
+struct compose_space {
+    char *rows;
+    size_t size;
+    int counts[256];
+};
+
+/*
+ * How much bigger the animation is shown than it is drawn. Viewport
+ * coordinates are in scaled cells.
+ */
+double scale = 1.0;
+
+/*
+ * The size of n cells of the animation once scaled.
+ */
+int scaled(int n) {
+    return (int) (n * scale + 0.5);
+}
+
+static int floor_of(double v) {
+    int n = (int) v;
+    return n > v ? n - 1 : n;
+}
+
+/*
+ * The cells of the animation, from *lo up to *hi, that scaled cell
+ * n is made from: the nearest one when scaling up, and all that it
+ * covers when scaling down.
+ */
+static void scale_span(int n, int *lo, int *hi) {
+    if (scale >= 1) {
+        *lo = floor_of((n + 0.5) / scale);
+        *hi = *lo + 1;
+    } else {
+        *lo = floor_of(n / scale);
+        *hi = floor_of((n + 1) / scale);
+        if (*hi <= *lo) *hi = *lo + 1;
+    }
+}
+
+static void sampling_setup(void) {
+    int width = max_col > min_col ? max_col - min_col : 0;
+    int x, y, lo, hi, most = 1;
+
+    if (scale == 1.0 || !width) return;
+    scale_span(min_col, &sampling.src_from, &hi);
+    scale_span(max_col - 1, &lo, &hi);
+    sampling.src_width = hi - sampling.src_from;
+    for (y = min_row; y < max_row; ++y) {
+        scale_span(y, &lo, &hi);
+        if (hi - lo > most) most = hi - lo;
+    }
+    sampling.most = most;
+    free(sampling.col_lo);
+    free(sampling.col_hi);
+    sampling.col_lo = malloc(width * sizeof(int));
+    sampling.col_hi = malloc(width * sizeof(int));
+    if (!sampling.col_lo || !sampling.col_hi) {
+        perror("malloc");
+        exit(1);
+    }
+    for (x = 0; x < width; ++x) {
+        scale_span(min_col + x, &lo, &hi);
+        sampling.col_lo[x] = lo - sampling.src_from;
+        sampling.col_hi[x] = hi - sampling.src_from;
+    }
+}
+
+/*
+ * Make room in a compose_space for the current sampling.
+ */
+static void space_reserve(struct compose_space *space) {
+    size_t size = (size_t) sampling.most * sampling.src_width;
+    if (scale == 1.0 || space->size >= size) return;
+    free(space->rows);
+    space->rows = malloc(size);
+    if (!space->rows) {
+        perror("malloc");
+        exit(1);
+    }
+    space->size = size;
+}
+
+/*
+ * Compose row y of the viewport for frame i. above is the row
+ * composed just before it, if any, which scaling up often repeats.
+ *
+ * When scaling down, each cell gets the color that most of the
+ * cells it covers have, as color indices can't be averaged.
+ */
+static void compose_row(struct compose_space *space, char *cells, const char *above, size_t i, int y) {
+    int width = max_col - min_col;
+    int *counts = space->counts;
+    int lo, hi, prev_lo, prev_hi, r, x;
+
+    if (scale == 1.0) {
+        compose_span(cells, i, y, min_col, max_col);
+        return;
+    }
+    scale_span(y, &lo, &hi);
+    if (above) {
+        scale_span(y - 1, &prev_lo, &prev_hi);
+        if (prev_lo == lo && prev_hi == hi) {
+            memcpy(cells, above, width);
+            return;
+        }
+    }
+    for (r = lo; r < hi; ++r) {
+        compose_span(space->rows + (size_t) (r - lo) * sampling.src_width, i, r,
+                sampling.src_from, sampling.src_from + sampling.src_width);
+    }
+    for (x = 0; x < width; ++x) {
+        int from = sampling.col_lo[x], to = sampling.col_hi[x], c, best = 0;
+        if (hi - lo == 1 && to - from == 1) {
+            cells[x] = space->rows[from];
+            continue;
+        }
+        for (r = 0; r < hi - lo; ++r) {
+            const char *src = space->rows + (size_t) r * sampling.src_width;
+            for (c = from; c < to; ++c) {
+                unsigned char color = src[c];
+                if (++counts[color] > best) {
+                    best = counts[color];
+                    cells[x] = color;
+                }
+            }
+        }
+        /* Clear the counts again, only the ones that were used */
+        for (r = 0; r < hi - lo; ++r) {
+            const char *src = space->rows + (size_t) r * sampling.src_width;
+            for (c = from; c < to; ++c) {
+                counts[(unsigned char) src[c]] = 0;
+            }
+        }
+    }
+}
+
+/*
+ * Compose frame i of the animation, cropped to the current
+ * viewport, into one color index per cell. When scaled, the
+ * viewport has to be the one cache_build() last worked out the
+ * sampling for.
+ */
+void compose_frame(char *grid, size_t i) {
+    static struct compose_space space;
+    int y;
+    size_t width = max_col > min_col ? max_col - min_col : 0;
+
+    space_reserve(&space);
+    for (y = min_row; y < max_row; ++y) {
+        compose_row(&space, grid, y > min_row ? grid - width : NULL, i, y);
+        grid += width;
+    }
+}
+
+/*
+ * The color escapes and output characters with their lengths, and
+ * the span encoder that suits them, all worked out by encode_setup()
+ * so that nothing has to be measured or checked per cell.
+ */
+struct escape {
+    const char *data;
+    size_t len;
+};
+
+static struct escape palette[256];
+static struct escape fg_palette[256];
+static const char *cell_output;     /* What a cell in the background color is drawn as */
+static size_t output_len;
+static char output_fill;    /* Character cell_output consists of, or 0 if mixed */
+static int merge_escapes;   /* Whether a foreground and a background escape can share one CSI */
+
+/*
+ * Cells per character cell in the current glyph mode, how many
+ * terminal columns each character cell takes, and the block
+ * character for each pattern of foreground cells. Bit k of a
+ * pattern is cell k, counted along the rows from the top left.
+ */
+static int cell_across = 1, cell_down = 1, cell_columns = 2;
+static unsigned char full_pattern;
+static char glyphs[64][5];
+static size_t glyph_len[64];
+
+static void (*encode_span)(struct buffer *out, const char *cells, int n, char *last);
+
+/*
+ * Append to a buffer that is most likely big enough already.
+ */
+static inline void put(struct buffer *out, const char *data, size_t len) {
+    if (out->len + len > out->size) {
+        buffer_reserve(out, len);
+    }
+    memcpy(out->data + out->len, data, len);
+    out->len += len;
+}
+
+/*
+ * Write a number in decimal, returning how many digits it took.
+ */
+static inline int put_decimal(char *p, size_t value) {
+    char digits[24];
+    int n = 0, k;
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    for (k = 0; k < n; ++k) {
+        p[k] = digits[n - 1 - k];
+    }
+    return n;
+}
+
+/*
+ * Send n copies of the output characters in the current color.
+ *
+ * Long runs are collapsed: either by erasing them with the current
+ * background and stepping over them (ECH plus CUF), or by sending
+ * one character and repeating it (REP), whichever is shorter.
+ *
+ * The mode is passed in so that each specialized encoder below gets
+ * its own copy with the choice already made.
+ */
+static inline void encode_run(struct buffer *out, int n, enum rle_mode mode) {
+    size_t plain = n * output_len;
+    char seq[64];
+    int len = 0;
+
+    if (mode == RLE_ECH && plain > 8) {
+        seq[len++] = '\033';
+        seq[len++] = '[';
+        int d = put_decimal(seq + len, plain);
+        len += d;
+        seq[len++] = 'X';
+        seq[len++] = '\033';
+        seq[len++] = '[';
+        memcpy(seq + len, seq + 2, d);
+        len += d;
+        seq[len++] = 'C';
+    } else if (mode == RLE_REP && plain > 5) {
+        seq[len++] = cell_output[0];
+        seq[len++] = '\033';
+        seq[len++] = '[';
+        len += put_decimal(seq + len, plain - 1);
+        seq[len++] = 'b';
+    }
+    if (len > 0 && (size_t) len < plain) {
+        put(out, seq, len);
+        return;
+    }
+    buffer_reserve(out, plain);
+    if (output_fill) {
+        memset(out->data + out->len, output_fill, plain);
+        out->len += plain;
+    } else {
+        while (n--) {
+            memcpy(out->data + out->len, cell_output, output_len);
+            out->len += output_len;
+        }
+    }
+}
+
+/*
+ * How many cells from the start of a span of n are in the color
+ * of the first one, found up to 64 cells at a time.
+ */
+static inline int run_length(const char *cells, int n) {
+    int run = 0;
+    while (run < n - 1) {
+        int k = n - 1 - run < 64 ? n - 1 - run : 64;
+        uint64_t ends = scan_diff(cells + run, cells + run + 1, k);
+        if (ends) return run + __builtin_ctzll(ends) + 1;
+        run += k;
+    }
+    return n;
+}
+
+/*
+ * The first cell from x on that differs between two rows of n
+ * cells, or n if none do.
+ */
+static inline int next_change(const char *a, const char *b, int x, int n) {
+    while (x < n) {
+        int k = n - x < 64 ? n - x : 64;
+        uint64_t changed = scan_diff(a + x, b + x, k);
+        if (changed) return x + __builtin_ctzll(changed);
+        x += k;
+    }
+    return n;
+}
+
+/*
+ * Send a span of cells that all have a color, with an escape
+ * whenever the color changes.
+ */
+static inline void encode_solid(struct buffer *out, const char *cells, int n, char *last,
+        enum rle_mode mode) {
+    int x = 0;
+    while (x < n) {
+        char color = cells[x];
+        int run = run_length(cells + x, n - x);
+        if (color != *last) {
+            const struct escape *e = &palette[(unsigned char) color];
+            *last = color;
+            put(out, e->data, e->len);
+        }
+        encode_run(out, run, mode);
+        x += run;
+    }
+}
+
+static void encode_solid_plain(struct buffer *out, const char *cells, int n, char *last) {
+    encode_solid(out, cells, n, last, RLE_NONE);
+}
+
+static void encode_solid_ech(struct buffer *out, const char *cells, int n, char *last) {
+    encode_solid(out, cells, n, last, RLE_ECH);
+}
+
+static void encode_solid_rep(struct buffer *out, const char *cells, int n, char *last) {
+    encode_solid(out, cells, n, last, RLE_REP);
+}
+
+/*
+ * The colors the terminal currently draws with in the glyph modes,
+ * 0 where not known.
+ */
+struct pen {
+    char fg;
+    char bg;
+};
+
+/*
+ * A character cell in a glyph mode: the block character pattern,
+ * and the colors of the cells in it and of the ones left out.
+ */
+struct glyph {
+    unsigned char pattern;
+    char fg;
+    char bg;
+};
+
+/*
+ * Work out character cell x of a terminal row, from the rows of
+ * cells starting at cells (only nrows of them there, the rest and
+ * anything right of width count as background).
+ *
+ * A character cell only has two colors, so the most common one
+ * becomes the background and the next most common the foreground.
+ * Cells in any other color are drawn in the background.
+ */
+static inline void glyph_at(const char *cells, int width, int nrows, int x, struct glyph *g) {
+    char cell[6], seen[6] = {0};
+    int counts[6], distinct = 0, row, col, k = 0, j;
+
+    for (row = 0; row < cell_down; ++row) {
+        for (col = 0; col < cell_across; ++col) {
+            int cx = x * cell_across + col;
+            char c = row < nrows && cx < width ? cells[(size_t) row * width + cx] : ',';
+            cell[k++] = c;
+            for (j = 0; j < distinct && seen[j] != c; ++j);
+            if (j == distinct) {
+                seen[distinct] = c;
+                counts[distinct++] = 0;
+            }
+            counts[j]++;
+        }
+    }
+    int bg = 0, fg = -1;
+    for (j = 1; j < distinct; ++j) {
+        if (counts[j] > counts[bg]) bg = j;
+    }
+    for (j = 0; j < distinct; ++j) {
+        if (j != bg && (fg < 0 || counts[j] > counts[fg])) fg = j;
+    }
+    g->bg = seen[bg];
+    g->fg = fg < 0 ? 0 : seen[fg];
+    g->pattern = 0;
+    for (j = 0; j < k; ++j) {
+        if (fg >= 0 && cell[j] == g->fg) g->pattern |= 1 << j;
+    }
+}
+
+/*
+ * Switch the pen to a foreground (0 if any will do) and background,
+ * sending only what changes, in one escape where possible.
+ */
+static inline void set_pen(struct buffer *out, struct pen *pen, char fg, char bg) {
+    const struct escape *f = &fg_palette[(unsigned char) fg];
+    const struct escape *b = &palette[(unsigned char) bg];
+    int need_fg = fg && fg != pen->fg, need_bg = bg != pen->bg;
+
+    if (need_fg && need_bg && merge_escapes) {
+        put(out, f->data, f->len - 1);
+        put(out, ";", 1);
+        put(out, b->data + 2, b->len - 2);
+    } else {
+        if (need_fg) put(out, f->data, f->len);
+        if (need_bg) put(out, b->data, b->len);
+    }
+    if (need_fg) pen->fg = fg;
+    if (need_bg) pen->bg = bg;
+}
+
+/*
+ * Send n copies of a block character, repeating it with REP where
+ * that is shorter.
+ */
+static void encode_glyph_run(struct buffer *out, unsigned char pattern, int n) {
+    size_t len = glyph_len[pattern];
+    if (rle_mode == RLE_REP && n > 1) {
+        char seq[64];
+        int rep = 0;
+        memcpy(seq, glyphs[pattern], len);
+        rep = len;
+        seq[rep++] = '\033';
+        seq[rep++] = '[';
+        rep += put_decimal(seq + rep, n - 1);
+        seq[rep++] = 'b';
+        if ((size_t) rep < n * len) {
+            put(out, seq, rep);
+            return;
+        }
+    }
+    buffer_reserve(out, n * len);
+    while (n--) {
+        memcpy(out->data + out->len, glyphs[pattern], len);
+        out->len += len;
+    }
+}
+
+/*
+ * Send n character cells of a terminal row, starting at x, in a
+ * glyph mode. The cells of each character cell are taken from
+ * the nrows rows of width cells starting at cells.
+ *
+ * A pattern and its inverse look the same with the colors swapped,
+ * so whichever needs fewer color changes is sent.
+ */
+static void encode_glyphs(struct buffer *out, const char *cells, int width, int nrows, int x, int n,
+        struct pen *pen) {
+    struct glyph g = {0, 0, 0}, next = {0, 0, 0};
+    int end = x + n;
+
+    if (x < end) glyph_at(cells, width, nrows, x, &g);
+    while (x < end) {
+        int run = 1;
+        while (x + run < end) {
+            glyph_at(cells, width, nrows, x + run, &next);
+            if (next.pattern != g.pattern || next.fg != g.fg || next.bg != g.bg) break;
+            ++run;
+        }
+        if (!g.pattern && (pen->bg == g.bg || pen->fg != g.bg)) {
+            /* One color, which runs of spaces can be collapsed for */
+            set_pen(out, pen, 0, g.bg);
+            encode_run(out, run, rle_mode);
+        } else {
+            unsigned char pattern = g.pattern;
+            char fg = g.fg, bg = g.bg;
+            if (!pattern) {
+                /* The foreground already has the color, so a full block saves an escape */
+                pattern = full_pattern;
+                fg = bg;
+                bg = pen->bg;
+            } else if ((pen->fg != bg) + (pen->bg != fg) < (pen->fg != fg) + (pen->bg != bg)) {
+                pattern ^= full_pattern;
+                fg = g.bg;
+                bg = g.fg;
+            }
+            set_pen(out, pen, fg, bg);
+            encode_glyph_run(out, pattern, run);
+        }
+        x += run;
+        g = next;
+    }
+}
+
+/*
+ * Send a whole terminal row in a glyph mode, leaving the background
+ * of its last character cell active.
+ */
+static void encode_glyph_row(struct buffer *out, const char *cells, int width, int nrows, struct pen *pen) {
+    int across = (width + cell_across - 1) / cell_across;
+    struct glyph g;
+
+    encode_glyphs(out, cells, width, nrows, 0, across, pen);
+    if (across) {
+        glyph_at(cells, width, nrows, across - 1, &g);
+        set_pen(out, pen, 0, g.bg);
+    }
+}
+
+/*
+ * UTF-8 for a code point, returning its length.
+ */
+static size_t utf8(char *p, unsigned cp) {
+    if (cp < 0x80) {
+        p[0] = cp;
+        return 1;
+    }
+    if (cp < 0x10000) {
+        p[0] = 0xe0 | cp >> 12;
+        p[1] = 0x80 | (cp >> 6 & 0x3f);
+        p[2] = 0x80 | (cp & 0x3f);
+        return 3;
+    }
+    p[0] = 0xf0 | cp >> 18;
+    p[1] = 0x80 | (cp >> 12 & 0x3f);
+    p[2] = 0x80 | (cp >> 6 & 0x3f);
+    p[3] = 0x80 | (cp & 0x3f);
+    return 4;
+}
+
+/*
+ * Fill in the block characters for the glyph mode.
+ */
+static void glyph_setup(void) {
+    static const unsigned half[4] = {0x20, 0x2580, 0x2584, 0x2588};
+    static const unsigned quadrant[16] = {
+        0x20, 0x2598, 0x259d, 0x2580, 0x2596, 0x258c, 0x259e, 0x259b,
+        0x2597, 0x259a, 0x2590, 0x259c, 0x2584, 0x2599, 0x259f, 0x2588,
+    };
+    int k;
+
+    cell_across = glyph_shapes[glyph_mode].across;
+    cell_down = glyph_shapes[glyph_mode].down;
+    full_pattern = (1 << (cell_across * cell_down)) - 1;
+    if (glyph_mode == GLYPH_SPACES) return;
+    for (k = 0; k <= full_pattern; ++k) {
+        unsigned cp;
+        if (glyph_mode == GLYPH_HALF) {
+            cp = half[k];
+        } else if (glyph_mode == GLYPH_QUADRANT) {
+            cp = quadrant[k];
+        } else if (k == 0 || k == 21 || k == 42 || k == 63) {
+            /* Blank, left half, right half and full, which exist already */
+            cp = k == 0 ? 0x20 : k == 21 ? 0x258c : k == 42 ? 0x2590 : 0x2588;
+        } else {
+            /* Sextants, in the order of their patterns without the above */
+            cp = 0x1fb00 + k - 1 - (k > 21) - (k > 42);
+        }
+        glyph_len[k] = utf8(glyphs[k], cp);
+    }
+}
+
+/*
+ * Measure the escapes and pick the span encoder for the current
+ * colors, output characters, glyph mode and run-length mode.
+ */
+void encode_setup(void) {
+    int c;
+    merge_escapes = 1;
+    for (c = 0; c < 256; ++c) {
+        palette[c].data = colors[c];
+        palette[c].len = colors[c] ? strlen(colors[c]) : 0;
+        fg_palette[c].data = fg_colors[c];
+        fg_palette[c].len = fg_colors[c] ? strlen(fg_colors[c]) : 0;
+        if (used[c] && (!colors[c] || !fg_colors[c] || strncmp(colors[c], "\033[", 2) ||
+                colors[c][palette[c].len - 1] != 'm' || fg_palette[c].data[fg_palette[c].len - 1] != 'm')) {
+            merge_escapes = 0;
+        }
+    }
+    /* In glyph modes, a cell in only the background color is a space */
+    cell_output = glyph_mode == GLYPH_SPACES ? output : " ";
+    output_len = strlen(cell_output);
+    output_fill = cell_output[0];
+    for (c = 1; cell_output[c]; ++c) {
+        if (cell_output[c] != cell_output[0]) output_fill = 0;
+    }
+    glyph_setup();
+    scan_setup();
+    cell_columns = glyph_mode == GLYPH_SPACES ? output_len : 1;
+
+    if (rle_mode == RLE_ECH) {
+        encode_span = encode_solid_ech;
+    } else if (rle_mode == RLE_REP) {
+        encode_span = encode_solid_rep;
+    } else {
+        encode_span = encode_solid_plain;
+    }
+}
+
+/*
+ * Encode a composed frame in full, including the cursor
+ * reset that precedes it.
+ */
+void encode_frame(struct buffer *out, const char *grid, int width, int height) {
+    char last = 0;      /* Last color index rendered */
+    struct pen pen = {0, 0};
+    int y;
+
+    /* Reset cursor */
+    if (clear_screen) {
+        buffer_append_str(out, "\033[H");
+    } else {
+        buffer_append_str(out, "\033[u");
+    }
+    /* Render the frame */
+    for (y = 0; y < height; y += cell_down) {
+        if (glyph_mode == GLYPH_SPACES) {
+            encode_span(out, grid + (size_t) y * width, width, &last);
+        } else {
+            int nrows = height - y < cell_down ? height - y : cell_down;
+            encode_glyph_row(out, grid + (size_t) y * width, width, nrows, &pen);
+        }
+        /* End of row, send newline */
+        buffer_append(out, "\n", 1);
+    }
+}
+
+/*
+ * Move the cursor to a cell of the viewport.
+ */
+static void encode_move(struct buffer *out, int y, int x) {
+    char seq[64];
+    int len = 2;
+    seq[0] = '\033';
+    seq[1] = '[';
+    len += put_decimal(seq + len, y + 1);
+    seq[len++] = ';';
+    len += put_decimal(seq + len, x * cell_columns + 1);
+    seq[len++] = 'H';
+    put(out, seq, len);
+}
+
+/*
+ * Encode only the cells that differ between two composed frames.
+ *
+ * Changed cells are sent in runs, each preceded by a cursor move.
+ * Runs separated by fewer than DELTA_MERGE_GAP unchanged cells are
+ * merged, as resending those is cheaper than another move. The
+ * cursor is left below the frame with the color of the last cell
+ * active, same as after a full frame.
+ */
+#define DELTA_MERGE_GAP 4
+
+/*
+ * Whether any cell of character cell x differs between two rows
+ * of character cells in a glyph mode.
+ */
+static int glyph_changed(const char *prev, const char *cur, int width, int nrows, int x) {
+    int row, col;
+    for (row = 0; row < nrows; ++row) {
+        for (col = x * cell_across; col < (x + 1) * cell_across && col < width; ++col) {
+            if (prev[(size_t) row * width + col] != cur[(size_t) row * width + col]) return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * encode_delta() for the glyph modes, a character cell at a time.
+ */
+static void encode_delta_glyphs(struct buffer *out, const char *prev, const char *cur, int width, int height) {
+    struct pen pen = {0, 0};
+    int across = (width + cell_across - 1) / cell_across;
+    int y, x;
+
+    for (y = 0; y * cell_down < height; ++y) {
+        size_t start = (size_t) y * cell_down * width;
+        int nrows = height - y * cell_down < cell_down ? height - y * cell_down : cell_down;
+        x = 0;
+        while (x < across) {
+            if (!glyph_changed(prev + start, cur + start, width, nrows, x)) {
+                ++x;
+                continue;
+            }
+            int end = x + 1, scan;
+            for (scan = end; scan < across && scan - end < DELTA_MERGE_GAP; ++scan) {
+                if (glyph_changed(prev + start, cur + start, width, nrows, scan)) end = scan + 1;
+            }
+            encode_move(out, y, x);
+            encode_glyphs(out, cur + start, width, nrows, x, end - x, &pen);
+            x = end;
+        }
+    }
+    encode_move(out, y, 0);
+    if (width && height) {
+        /* Leave the background of the last character cell, same as after a full frame */
+        struct glyph g;
+        glyph_at(cur + (size_t) (y - 1) * cell_down * width, width, height - (y - 1) * cell_down,
+                across - 1, &g);
+        set_pen(out, &pen, 0, g.bg);
+    }
+}
+
+void encode_delta(struct buffer *out, const char *prev, const char *cur, int width, int height) {
+    char last = 0;
+    int y, x;
+
+    if (glyph_mode != GLYPH_SPACES) {
+        encode_delta_glyphs(out, prev, cur, width, height);
+        return;
+    }
+
+    for (y = 0; y < height; ++y) {
+        const char *p = prev + (size_t) y * width;
+        const char *c = cur + (size_t) y * width;
+        x = next_change(p, c, 0, width);
+        while (x < width) {
+            int end = x + 1, next;
+            while ((next = next_change(p, c, end, width)) < width && next - end < DELTA_MERGE_GAP) {
+                end = next + 1;
+            }
+            encode_move(out, y, x);
+            encode_span(out, c + x, end - x, &last);
+            x = next;
+        }
+    }
+    encode_move(out, height, 0);
+    if (width && height) {
+        char final = cur[(size_t) width * height - 1];
+        const struct escape *e = &palette[(unsigned char) final];
+        if (final != last && e->data) {
+            put(out, e->data, e->len);
+        }
+    }
+}
+
+/*
+ * The color the terminal is left in after a row of cells,
+ * given the one it was in before.
+ */
+static char row_color(const char *cells, int width, char last) {
+    while (width--) {
+        if (palette[(unsigned char) cells[width]].data) return cells[width];
+    }
+    return last;
+}
+
+/*
+ * How many threads cache_build() may encode with. Each gets a band
+ * of rows, and later a share of the transitions, but only once
+ * there are at least BAND_CELLS cells of the viewport per thread,
+ * as starting a thread costs more than encoding a small band.
+ */
+int encode_threads = 1;
+
+#define BAND_CELLS 8192
+
+/*
+ * Run a function on each of n jobs laid out size bytes apart, the
+ * first on the calling thread and the others on threads of their
+ * own. Jobs whose thread can't be started run here instead.
+ */
+static void run_jobs(void *(*fn)(void *), void *jobs, size_t size, int n) {
+    pthread_t threads[MAX_ENCODE_THREADS];
+    int started[MAX_ENCODE_THREADS] = {0};
+    int k;
+
+    for (k = 1; k < n; ++k) {
+        started[k] = pthread_create(&threads[k], NULL, fn, (char *) jobs + k * size) == 0;
+    }
+    fn(jobs);
+    for (k = 1; k < n; ++k) {
+        if (started[k]) {
+            pthread_join(threads[k], NULL);
+        } else {
+            fn((char *) jobs + k * size);
+        }
+    }
+}
+
+/*
+ * Terminal rows from up to to of every frame, composed into the
+ * new grid and encoded into a buffer of the band's own. Rows still
+ * in view are carried over from the previous build, shifted by
+ * shift terminal rows.
+ */
+struct band {
+    const struct frame_cache *old;
+    int reuse;
+    int shift;
+    char *grid;
+    size_t *row_offset;     /* Shared, the band fills in its own rows */
+    int from;
+    int to;
+    struct buffer rows;
+    struct compose_space space;
+};
+
+static void *encode_band(void *arg) {
+    struct band *band = arg;
+    const struct frame_cache *old = band->old;
+    size_t i, count = frames_length();
+    int width = max_col > min_col ? max_col - min_col : 0;
+    int height = max_row > min_row ? max_row - min_row : 0;
+    int rows_down = (height + cell_down - 1) / cell_down;
+    size_t cells = (size_t) width * height;
+    size_t old_cells = (size_t) old->width * old->height;
+    int y;
+
+    space_reserve(&band->space);
+    for (i = 0; i < count; ++i) {
+        for (y = band->from; y < band->to; ++y) {
+            char *row = band->grid + i * cells + (size_t) y * cell_down * width;
+            int nrows = height - y * cell_down < cell_down ? height - y * cell_down : cell_down;
+            int old_y = y + band->shift;
+            int old_rows = old->height - old_y * cell_down;
+            band->row_offset[i * rows_down + y] = band->rows.len;
+            if (band->reuse && old_y >= 0 && old_y < old->rows_down &&
+                    (old_rows < cell_down ? old_rows : cell_down) == nrows) {
+                size_t k = i * old->rows_down + old_y;
+                memcpy(row, old->grid + i * old_cells + (size_t) old_y * cell_down * width, (size_t) nrows * width);
+                buffer_append(&band->rows, old->rows.data + old->row_offset[k],
+                        old->row_offset[k + 1] - old->row_offset[k]);
+            } else {
+                int r;
+                for (r = 0; r < nrows; ++r) {
+                    char *cells = row + (size_t) r * width;
+                    /* Rows above the band may not be there yet */
+                    compose_row(&band->space, cells, y > band->from || r ? cells - width : NULL, i,
+                            min_row + y * cell_down + r);
+                }
+                /* Start every row with its own color, so it can stand alone */
+                if (glyph_mode == GLYPH_SPACES) {
+                    char last = 0;
+                    encode_span(&band->rows, row, width, &last);
+                } else {
+                    struct pen pen = {0, 0};
+                    encode_glyph_row(&band->rows, row, width, nrows, &pen);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Transitions into frames first up to last, each left out if it
+ * is no smaller than the full frame.
+ */
+struct delta_job {
+    const struct frame_cache *cache;
+    size_t first;
+    size_t last;
+    struct buffer out;
+    size_t offset[MAX_FRAMES + 1];
+};
+
+static void *encode_deltas(void *arg) {
+    struct delta_job *job = arg;
+    const struct frame_cache *cache = job->cache;
+    size_t cells = (size_t) cache->width * cache->height;
+    size_t i;
+
+    for (i = job->first; i < job->last; ++i) {
+        size_t prev = (i + cache->count - 1) % cache->count;
+        job->offset[i] = job->out.len;
+        encode_delta(&job->out, cache->grid + prev * cells, cache->grid + i * cells, cache->width, cache->height);
+        if (job->out.len - job->offset[i] >= cache->offset[i + 1] - cache->offset[i]) {
+            job->out.len = job->offset[i];
+        }
+    }
+    job->offset[i] = job->out.len;
+    return NULL;
+}
+
+/*
+ * Hash of everything but the viewport that goes into the encoded
+ * rows: the colors, flag layout, modes and the encoder version.
+ */
+static uint64_t encoding_key(void) {
+    static const uint32_t version = ENCODER_VERSION;
+    int settings[] = {clear_screen, render_mode, rle_mode, glyph_mode, (int) frames->count};
+    uint64_t h = hash_bytes(0xcbf29ce484222325ULL, &version, sizeof(version));
+    int c;
+
+    for (c = 0; c < 256; ++c) {
+        h = hash_bytes(h, colors[c] ? colors[c] : "", colors[c] ? strlen(colors[c]) + 1 : 0);
+        h = hash_bytes(h, fg_colors[c] ? fg_colors[c] : "", fg_colors[c] ? strlen(fg_colors[c]) + 1 : 0);
+    }
+    h = hash_bytes(h, output, strlen(output));
+    h = hash_bytes(h, rainbow, strlen(rainbow));
+    return hash_bytes(h, settings, sizeof(settings));
+}
+
+/*
+ * Encode every frame of the animation up front. The result only
+ * depends on the flag, the color table and the viewport, so it
+ * has to be rebuilt when the terminal is resized but can be sent
+ * as-is on every other tick.
+ *
+ * Each row is composed and encoded on its own, so that when only
+ * the height changes, the rows still in view are carried over from
+ * the previous build instead of being redone. Full frames are then
+ * put together from the rows. With encode_threads above 1, large
+ * viewports are split into bands of rows encoded side by side.
+ *
+ * In delta mode, the transition into each frame from the one
+ * before it is encoded as well, unless it is no smaller than
+ * the full frame.
+ */
+void cache_build(struct frame_cache *cache) {
+    static struct band bands[MAX_ENCODE_THREADS];
+    static struct delta_job jobs[MAX_ENCODE_THREADS];
+    size_t i, cells, count = frames_length();
+    int width = max_col > min_col ? max_col - min_col : 0;
+    int height = max_row > min_row ? max_row - min_row : 0;
+    int y, b, nbands;
+    uint64_t encoding;
+
+    encode_setup();
+    sampling_setup();
+    if (cache->borrowed) {
+        /* Nothing to carry over from frames that aren't ours, see store.c */
+        cache->data = cache->deltas = (struct buffer) {0};
+        cache->grid = NULL;
+        cache->count = 0;
+        cache->borrowed = 0;
+    }
+
+    /* Terminal rows, each covering cell_down rows of cells, the last one maybe fewer */
+    int rows_down = (height + cell_down - 1) / cell_down;
+
+    /*
+     * Rows can only be carried over if they are as wide and as
+     * scaled as before, cover the same rows of cells, and were
+     * encoded with the same colors and modes.
+     */
+    int shift = min_row - cache->min_row;
+    encoding = encoding_key();
+    int reuse = cache->count == count && cache->min_col == min_col && cache->max_col == max_col &&
+            cache->scale == scale && cache->encoding == encoding && shift % cell_down == 0;
+
+    cells = (size_t) width * height;
+    char *grid = malloc(cells * count + 1);
+    size_t *row_offset = malloc((count * rows_down + 1) * sizeof(*row_offset));
+    if (!grid || !row_offset) {
+        perror("malloc");
+        exit(1);
+    }
+
+    nbands = encode_threads < MAX_ENCODE_THREADS ? encode_threads : MAX_ENCODE_THREADS;
+    if ((size_t) nbands > cells / BAND_CELLS) nbands = cells / BAND_CELLS;
+    if (nbands > rows_down) nbands = rows_down;
+    if (nbands < 1) nbands = 1;
+    for (b = 0; b < nbands; ++b) {
+        bands[b].old = cache;
+        bands[b].reuse = reuse;
+        bands[b].shift = shift / cell_down;
+        bands[b].grid = grid;
+        bands[b].row_offset = row_offset;
+        bands[b].from = rows_down * b / nbands;
+        bands[b].to = rows_down * (b + 1) / nbands;
+        bands[b].rows.len = 0;
+    }
+    run_jobs(encode_band, bands, sizeof(bands[0]), nbands);
+
+    /* Put the bands back together in order, frame by frame */
+    struct buffer rows = {0};
+    for (i = 0; i < count; ++i) {
+        for (b = 0; b < nbands; ++b) {
+            size_t start = row_offset[i * rows_down + bands[b].from];
+            size_t end = i + 1 < count ? row_offset[(i + 1) * rows_down + bands[b].from] : bands[b].rows.len;
+            for (y = bands[b].from; y < bands[b].to; ++y) {
+                row_offset[i * rows_down + y] += rows.len - start;
+            }
+            if (end > start) buffer_append(&rows, bands[b].rows.data + start, end - start);
+        }
+    }
+    row_offset[count * rows_down] = rows.len;
+
+    free(cache->grid);
+    free(cache->row_offset);
+    buffer_free(&cache->rows);
+    cache->grid = grid;
+    cache->row_offset = row_offset;
+    cache->rows = rows;
+    cache->count = count;
+    cache->width = width;
+    cache->height = height;
+    cache->rows_down = rows_down;
+    cache->min_row = min_row;
+    cache->min_col = min_col;
+    cache->max_col = max_col;
+    cache->scale = scale;
+    cache->encoding = encoding;
+
+    cache->data.len = 0;
+    for (i = 0; i < count; ++i) {
+        char last = 0;
+        cache->offset[i] = cache->data.len;
+        /* Reset cursor */
+        buffer_append_str(&cache->data, clear_screen ? "\033[H" : "\033[u");
+        for (y = 0; y < rows_down; ++y) {
+            const char *row = grid + i * cells + (size_t) y * cell_down * width;
+            size_t start = row_offset[i * rows_down + y];
+            /* Leave out the leading escape if the color is already active */
+            if (glyph_mode == GLYPH_SPACES && width && row[0] == last &&
+                    palette[(unsigned char) last].data) {
+                start += palette[(unsigned char) last].len;
+            }
+            buffer_append(&cache->data, cache->rows.data + start, row_offset[i * rows_down + y + 1] - start);
+            buffer_append(&cache->data, "\n", 1);
+            if (glyph_mode == GLYPH_SPACES) {
+                last = row_color(row, width, last);
+            }
+        }
+    }
+    cache->offset[count] = cache->data.len;
+
+    cache->deltas.len = 0;
+    if (render_mode == RENDER_DELTA) {
+        int njobs = (size_t) nbands < count ? nbands : (int) count;
+        for (b = 0; b < njobs; ++b) {
+            jobs[b].cache = cache;
+            jobs[b].first = count * b / njobs;
+            jobs[b].last = count * (b + 1) / njobs;
+            jobs[b].out.len = 0;
+        }
+        run_jobs(encode_deltas, jobs, sizeof(jobs[0]), njobs);
+        for (b = 0; b < njobs; ++b) {
+            for (i = jobs[b].first; i < jobs[b].last; ++i) {
+                cache->delta_offset[i] = cache->deltas.len + jobs[b].offset[i];
+            }
+            if (jobs[b].out.len) buffer_append(&cache->deltas, jobs[b].out.data, jobs[b].out.len);
+        }
+    }
+    cache->delta_offset[count] = cache->deltas.len;
+}
+
+/*
+ * A 64-bit hash of some bytes, carrying on from h, eight bytes at a
+ * time. It only has to tell a corrupt or stale cache from a good one.
+ */
+uint64_t hash_bytes(uint64_t h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    uint64_t word;
+    while (len >= 8) {
+        memcpy(&word, p, 8);
+        h = (h ^ word) * 0x100000001b3ULL;
+        h ^= h >> 29;
+        p += 8;
+        len -= 8;
+    }
+    word = len;
+    if (len) memcpy(&word, p, len);
+    h = (h ^ word) * 0x100000001b3ULL;
+    return h ^ h >> 29;
+}
+
+/*
+ * Hash of everything cache_build() goes by: the colors, flag layout,
+ * modes and viewport, and the version of the encoder, as any change
+ * to it may change the output as well.
+ */
+uint64_t cache_key(void) {
+    int viewport[] = {min_row, max_row, min_col, max_col};
+    uint64_t h = hash_bytes(encoding_key(), viewport, sizeof(viewport));
+    return hash_bytes(h, &scale, sizeof(scale));
+}
+
+/*
+ * Find the bytes that take the screen from frame prev to frame i.
+ * Pass -1 for prev when the screen contents are unknown.
+ * Returns whether the whole frame has to be sent.
+ *
+ * Transitions between frames that don't follow each other, as
+ * happens when frames are dropped, are encoded on the spot and
+ * stay valid until the next lookup.
+ */
+int cache_lookup(struct frame_cache *cache, long prev, size_t i, const char **data, size_t *len) {
+    size_t full = cache->offset[i + 1] - cache->offset[i];
+    size_t cells = (size_t) cache->width * cache->height;
+
+    if (render_mode == RENDER_DELTA && prev >= 0) {
+        if ((size_t) prev == (i + cache->count - 1) % cache->count) {
+            *len = cache->delta_offset[i + 1] - cache->delta_offset[i];
+            *data = cache->deltas.data + cache->delta_offset[i];
+        } else {
+            cache->scratch.len = 0;
+            encode_delta(&cache->scratch, cache->grid + prev * cells, cache->grid + i * cells,
+                    cache->width, cache->height);
+            *len = cache->scratch.len < full ? cache->scratch.len : 0;
+            *data = cache->scratch.data;
+        }
+        if (*len) {
+            return 0;
+        }
+    }
+    *data = cache->data.data + cache->offset[i];
+    *len = full;
+    return 1;
+}
+
+void cache_free(struct frame_cache *cache) {
+    if (!cache->borrowed) {
+        buffer_free(&cache->data);
+        buffer_free(&cache->deltas);
+        free(cache->grid);
+    }
+    cache->data = cache->deltas = (struct buffer) {0};
+    cache->borrowed = 0;
+    buffer_free(&cache->scratch);
+    buffer_free(&cache->rows);
+    free(cache->row_offset);
+    cache->grid = NULL;
+    cache->row_offset = NULL;
+    cache->count = 0;
+}
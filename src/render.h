@@ -0,0 +1,162 @@
+/*
+ * Frame composition and encoding for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FRAME_WIDTH  64
+#define FRAME_HEIGHT 64
+
+/*
+ * Upper bound on the number of frames in an animation,
+ * not counting the NULL terminator.
+ */
+#define MAX_FRAMES 16
+
+/*
+ * The animation as generated by pack-frames: frame i, row y is
+ * animation_rows[rows[i * FRAME_HEIGHT + y]], which holds 4-bit indices
+ * into animation_palette, two cells per byte with the left one in the
+ * low nibble.
+ */
+#define PACKED_ROW (FRAME_WIDTH / 2)
+
+struct packed_animation {
+    size_t count;
+    const unsigned short *rows;
+};
+
+/*
+ * Cell value for stripe k of the flag, counted from the top.
+ */
+#define STRIPE_CELL(k) ('A' + (k))
+
+/*
+ * Version of the encoded output. Bump it with any change to the
+ * bytes the encoder produces for the same settings (which the
+ * golden tests notice), so that frames kept from before, see
+ * store.c, are no longer used.
+ */
+#define ENCODER_VERSION 1
+
+/*
+ * Most threads cache_build() will encode with.
+ */
+#define MAX_ENCODE_THREADS 64
+
+enum render_mode {
+    RENDER_FULL, RENDER_DELTA
+};
+
+enum rle_mode {
+    RLE_NONE, RLE_ECH, RLE_REP
+};
+
+/*
+ * How the cells of the animation are drawn on the terminal: each
+ * as two spaces in its color, or several to a character cell with
+ * block characters in a foreground and a background color. Half
+ * blocks take 1x2 cells, quadrants 2x2 and sextants 2x3.
+ */
+enum glyph_mode {
+    GLYPH_SPACES, GLYPH_HALF, GLYPH_QUADRANT, GLYPH_SEXTANT
+};
+
+/*
+ * Growable byte buffer that encoded output is assembled into.
+ */
+struct buffer {
+    char *data;
+    size_t len;
+    size_t size;
+};
+
+void buffer_reserve(struct buffer *buf, size_t len);
+void buffer_append(struct buffer *buf, const char *data, size_t len);
+void buffer_append_str(struct buffer *buf, const char *str);
+void buffer_free(struct buffer *buf);
+
+/*
+ * Every frame of the animation encoded for the current
+ * flag, terminal type and viewport, stored back to back.
+ * Frame i occupies data[offset[i]] up to data[offset[i + 1]].
+ *
+ * deltas holds the transition into frame i from frame i - 1
+ * the same way, or nothing if the full frame is smaller.
+ * grid holds the composed cells of every frame, and scratch
+ * any transition that had to be encoded on the spot.
+ *
+ * rows holds every row of every frame encoded on its own, row y
+ * of frame i at rows[row_offset[i * rows_down + y]], which lets the
+ * next build reuse them for the viewport it was made for, as long as
+ * the colors and modes (encoding) are the same. Those are
+ * terminal rows, which cover several rows of cells in glyph modes.
+ *
+ * When borrowed is set, data, deltas and grid were loaded from
+ * elsewhere (see store.c) and are not freed or reused, and there
+ * are no rows.
+ */
+struct frame_cache {
+    struct buffer data;
+    size_t offset[MAX_FRAMES + 1];
+    struct buffer deltas;
+    size_t delta_offset[MAX_FRAMES + 1];
+    struct buffer scratch;
+    char *grid;
+    struct buffer rows;
+    size_t *row_offset;
+    int width;
+    int height;
+    int rows_down;
+    int min_row;
+    int min_col;
+    int max_col;
+    double scale;
+    uint64_t encoding;  /* encoding_key() of the rows */
+    size_t count;
+    int borrowed;
+};
+
+extern const char *colors[256];
+extern const char *fg_colors[256];
+extern const char *output;
+extern int clear_screen;
+extern const struct packed_animation *frames;
+extern enum render_mode render_mode;
+extern enum rle_mode rle_mode;
+extern enum glyph_mode glyph_mode;
+extern int encode_threads;
+
+extern int min_row;
+extern int max_row;
+extern int min_col;
+extern int max_col;
+extern double scale;
+
+int scaled(int n);
+int cells_across(int columns);
+int cells_down(int rows);
+void select_rainbow(const char *stripes);
+size_t frames_length(void);
+void compose_frame(char *grid, size_t i);
+/*
+ * encode_setup() has to be called before encode_frame() or
+ * encode_delta() whenever the colors, output, rle_mode or
+ * glyph_mode changed.
+ * cache_build() takes care of that itself.
+ */
+void encode_setup(void);
+void encode_frame(struct buffer *out, const char *grid, int width, int height);
+void encode_delta(struct buffer *out, const char *prev, const char *cur, int width, int height);
+void cache_build(struct frame_cache *cache);
+int cache_lookup(struct frame_cache *cache, long prev, size_t i, const char **data, size_t *len);
+void cache_free(struct frame_cache *cache);
+uint64_t hash_bytes(uint64_t h, const void *data, size_t len);
+uint64_t cache_key(void);
+
+#endif
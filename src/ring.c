@@ -0,0 +1,103 @@
+/*
+ * Frame hand-off between the render and writer threads.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <string.h>
+
+#include "ring.h"
+
+void ring_init(struct frame_ring *ring) {
+    memset(ring, 0, sizeof(*ring));
+    pthread_mutex_init(&ring->lock, NULL);
+    pthread_cond_init(&ring->cond, NULL);
+}
+
+/*
+ * Wake up the other side if it is waiting on us. The index was stored
+ * before waiting is read, and ring_wait() counts itself in before it
+ * reads the index, so either it sees the new index or it is counted
+ * here; all of these are sequentially consistent for that.
+ */
+static void ring_signal(struct frame_ring *ring) {
+    if (!__atomic_load_n(&ring->waiting, __ATOMIC_SEQ_CST)) return;
+    pthread_mutex_lock(&ring->lock);
+    pthread_cond_broadcast(&ring->cond);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+/*
+ * Producer: the next free slot to fill, or NULL if the ring is full.
+ */
+struct frame_slot *ring_acquire(struct frame_ring *ring) {
+    unsigned tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (ring->head - tail == RING_SLOTS) return NULL;
+    return &ring->slots[ring->head % RING_SLOTS];
+}
+
+/*
+ * Producer: hand the slot from ring_acquire() over to the consumer.
+ */
+void ring_publish(struct frame_ring *ring) {
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_SEQ_CST);
+    ring_signal(ring);
+}
+
+/*
+ * Consumer: the oldest filled slot, or NULL if the ring is empty.
+ */
+struct frame_slot *ring_peek(struct frame_ring *ring) {
+    unsigned head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (head == ring->tail) return NULL;
+    return &ring->slots[ring->tail % RING_SLOTS];
+}
+
+/*
+ * Consumer: give the slot from ring_peek() back to the producer.
+ */
+void ring_release(struct frame_ring *ring) {
+    __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_SEQ_CST);
+    ring_signal(ring);
+}
+
+/*
+ * Sleep until the producer has room or the consumer has a frame,
+ * or the ring was closed.
+ */
+void ring_wait(struct frame_ring *ring, int producer) {
+    pthread_mutex_lock(&ring->lock);
+    __atomic_add_fetch(&ring->waiting, 1, __ATOMIC_SEQ_CST);
+    while (!ring->closed) {
+        unsigned head = __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST);
+        unsigned tail = __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST);
+        if (producer ? head - tail < RING_SLOTS : head != tail) break;
+        pthread_cond_wait(&ring->cond, &ring->lock);
+    }
+    __atomic_sub_fetch(&ring->waiting, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+/*
+ * Free the frames in the slots, once neither side uses the ring.
+ */
+void ring_free(struct frame_ring *ring) {
+    int k;
+    for (k = 0; k < RING_SLOTS; ++k) {
+        buffer_free(&ring->slots[k].data);
+    }
+}
+
+/*
+ * Tell both sides to stop.
+ */
+void ring_close(struct frame_ring *ring) {
+    pthread_mutex_lock(&ring->lock);
+    __atomic_store_n(&ring->closed, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&ring->cond);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+int ring_closed(struct frame_ring *ring) {
+    return __atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE);
+}
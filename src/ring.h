@@ -0,0 +1,62 @@
+/*
+ * Frame hand-off between the render and writer threads.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "render.h"
+
+/*
+ * How many frames the renderer may get ahead of the writer.
+ */
+#define RING_SLOTS 4
+
+/*
+ * One encoded frame. data starts with the full frame, followed by
+ * the change from frame base to this one if that is smaller.
+ */
+struct frame_slot {
+    struct buffer data;
+    size_t full;        /* Length of the full frame */
+    size_t delta;       /* Length of the delta after it, or 0 */
+    long base;          /* Frame the delta applies to */
+    size_t frame;       /* Frame of the animation */
+    uint64_t tick;      /* Frame period the frame is due in */
+    unsigned generation;    /* Bumped whenever the viewport changes */
+};
+
+/*
+ * Single-producer, single-consumer ring of pre-allocated slots.
+ *
+ * head is only written by the producer and tail only by the consumer,
+ * so handing a slot over needs no lock. The mutex and condition are
+ * only used to sleep while the ring is full or empty, and waiting
+ * counts the threads doing so: the other side only takes the lock to
+ * wake them up when there are any.
+ */
+struct frame_ring {
+    struct frame_slot slots[RING_SLOTS];
+    unsigned head;
+    unsigned tail;
+    int closed;
+    int waiting;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+};
+
+void ring_init(struct frame_ring *ring);
+struct frame_slot *ring_acquire(struct frame_ring *ring);
+void ring_publish(struct frame_ring *ring);
+struct frame_slot *ring_peek(struct frame_ring *ring);
+void ring_release(struct frame_ring *ring);
+void ring_wait(struct frame_ring *ring, int producer);
+void ring_close(struct frame_ring *ring);
+void ring_free(struct frame_ring *ring);
+int ring_closed(struct frame_ring *ring);
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Microbenchmark for the cell comparison kernels of pride-nyancat.
+ *
+ * Times every kernel the processor can run on finding run boundaries
+ * within rows and changes between frames, in nanoseconds per cell.
+ * The real rows are those of the animation for a viewport of the
+ * given size (default 200x120 cells, scaled 3x so it is filled),
+ * the synthetic ones a wide viewport of random runs. Each kernel
+ * compares 200 million cells per workload, or as many as given. Run
+ * it as
+ *
+ *     ./scan-bench [width height [cells]]
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "flags.h"
+#include "render.h"
+#include "scan.h"
+
+/* Cells compared per kernel and workload, spread over repeated passes */
+static long bench_cells = 200000000;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Go over rows of width cells the way the encoder does, 64 at a
+ * time. With other set, find the cells that differ from it, and
+ * without, the run boundaries. Returns a count of the bits found,
+ * which also keeps the work from being optimized out.
+ */
+static unsigned long scan_rows(const char *cells, const char *other, int width, int height) {
+    unsigned long found = 0;
+    int y, x;
+    for (y = 0; y < height; ++y) {
+        const char *row = cells + (size_t) y * width;
+        int n = other ? width : width - 1;
+        for (x = 0; x < n; x += 64) {
+            int k = n - x < 64 ? n - x : 64;
+            uint64_t mask = other ? scan_diff(row + x, other + (size_t) y * width + x, k)
+                    : scan_diff(row + x, row + x + 1, k);
+            found += __builtin_popcountll(mask);
+        }
+    }
+    return found;
+}
+
+/*
+ * Time every kernel on frames of width by height cells, count of
+ * them back to back, comparing each with the next.
+ */
+static void bench(const char *name, const char *grid, int width, int height, int count) {
+    size_t cells = (size_t) width * height;
+    int passes = bench_cells / (cells * count) + 1;
+    unsigned long expect[2] = {0, 0};
+    int k, kind;
+
+    for (kind = 0; kind < 2; ++kind) {
+        printf("%-10s %-8s %5dx%-5d", name, kind ? "changes" : "runs", width, height);
+        for (k = 0; k < SCAN_KERNELS; ++k) {
+            unsigned long found = 0;
+            int pass, i;
+            double start;
+            if (scan_use(k) < 0) continue;
+            start = now();
+            for (pass = 0; pass < passes; ++pass) {
+                for (i = 0; i < count; ++i) {
+                    found += scan_rows(grid + i * cells, kind ? grid + (i + 1) % count * cells : NULL,
+                            width, height);
+                }
+            }
+            printf("  %s %6.3f ns", scan_kernel_names[k], (now() - start) * 1e9 / ((double) passes * count * cells));
+            if (k == SCAN_SCALAR) {
+                expect[kind] = found;
+            } else if (found != expect[kind]) {
+                printf("\n%s disagrees with %s\n", scan_kernel_names[k], scan_kernel_names[SCAN_SCALAR]);
+                exit(1);
+            }
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    char stripes[RAINBOW_ROWS + 3];
+    int width = argc > 2 ? atoi(argv[1]) : 200;
+    int height = argc > 2 ? atoi(argv[2]) : 120;
+    struct frame_cache cache = {0};
+    size_t i, count, cells;
+    char *grid;
+
+    if (argc > 3) bench_cells = atol(argv[3]);
+    if (width < 1 || height < 1 || bench_cells < 1) {
+        fprintf(stderr, "usage: %s [width height [cells]]\n", argv[0]);
+        return 1;
+    }
+
+    /* The animation, as the viewport shows it, composed the way the render thread does */
+    flag_rainbow(&flag_table[G], stripes);
+    select_rainbow(stripes);
+    compile_palette(&flag_table[G], 0);
+    scale = 3.0;
+    min_col = (scaled(FRAME_WIDTH) - width) / 2;
+    max_col = min_col + width;
+    min_row = (scaled(FRAME_HEIGHT) - height) / 2;
+    max_row = min_row + height;
+    cache_build(&cache);
+    bench("animation", cache.grid, width, height, cache.count);
+    cache_free(&cache);
+
+    /* A wide viewport of random runs from 1 to 16 cells, mostly kept between frames */
+    width = 4096;
+    height = 64;
+    count = 4;
+    cells = (size_t) width * height;
+    grid = malloc(cells * count);
+    if (!grid) {
+        perror("malloc");
+        return 1;
+    }
+    srand(1);
+    for (i = 0; i < cells; ) {
+        size_t run = 1 + rand() % 16;
+        memset(grid + i, 'A' + rand() % 8, run < cells - i ? run : cells - i);
+        i += run;
+    }
+    for (i = cells; i < cells * count; ++i) {
+        grid[i] = rand() % 8 ? grid[i - cells] : 'A' + rand() % 8;
+    }
+    bench("synthetic", grid, width, height, count);
+    free(grid);
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Comparing rows of cells, for pride-nyancat.
+ *
+ * Finding where a run of one color ends and which cells changed
+ * between frames both come down to comparing bytes, which vector
+ * instructions do 16 or 32 at a time. Which ones the processor has
+ * is only known once running, so the kernel is picked then.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include "scan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+const char *scan_kernel_names[SCAN_KERNELS] = {
+    [SCAN_SCALAR] = "scalar",
+    [SCAN_SSE2] = "sse2",
+    [SCAN_AVX2] = "avx2",
+};
+
+enum scan_kernel scan_kernel = SCAN_SCALAR;
+static int chosen;  /* Whether a kernel was picked yet */
+
+static uint64_t diff_scalar(const char *a, const char *b, int n) {
+    uint64_t mask = 0;
+    int x;
+    for (x = 0; x < n; ++x) {
+        mask |= (uint64_t) (a[x] != b[x]) << x;
+    }
+    return mask;
+}
+
+uint64_t (*scan_diff)(const char *a, const char *b, int n) = diff_scalar;
+
+#ifdef SCAN_X86
+__attribute__((target("sse2")))
+static uint64_t diff_sse2(const char *a, const char *b, int n) {
+    uint64_t mask = 0;
+    int x;
+    for (x = 0; x + 16 <= n; x += 16) {
+        __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + x)),
+                _mm_loadu_si128((const __m128i *) (b + x)));
+        mask |= (uint64_t) (~_mm_movemask_epi8(same) & 0xffff) << x;
+    }
+    for (; x < n; ++x) {
+        mask |= (uint64_t) (a[x] != b[x]) << x;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+static uint64_t diff_avx2(const char *a, const char *b, int n) {
+    uint64_t mask = 0;
+    int x;
+    for (x = 0; x + 32 <= n; x += 32) {
+        __m256i same = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (a + x)),
+                _mm256_loadu_si256((const __m256i *) (b + x)));
+        mask |= (uint64_t) ~(uint32_t) _mm256_movemask_epi8(same) << x;
+    }
+    if (x + 16 <= n) {
+        __m128i same = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (a + x)),
+                _mm_loadu_si128((const __m128i *) (b + x)));
+        mask |= (uint64_t) (~_mm_movemask_epi8(same) & 0xffff) << x;
+        x += 16;
+    }
+    for (; x < n; ++x) {
+        mask |= (uint64_t) (a[x] != b[x]) << x;
+    }
+    return mask;
+}
+#endif
+
+/*
+ * Whether the processor can run a kernel.
+ */
+int scan_available(enum scan_kernel kernel) {
+    switch (kernel) {
+        case SCAN_SCALAR:
+            return 1;
+#ifdef SCAN_X86
+        case SCAN_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case SCAN_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Switch to a kernel. Returns -1 if the processor can't run it.
+ */
+int scan_use(enum scan_kernel kernel) {
+    static uint64_t (*const kernels[SCAN_KERNELS])(const char *, const char *, int) = {
+        [SCAN_SCALAR] = diff_scalar,
+#ifdef SCAN_X86
+        [SCAN_SSE2] = diff_sse2,
+        [SCAN_AVX2] = diff_avx2,
+#endif
+    };
+
+    if (!scan_available(kernel)) return -1;
+    scan_kernel = kernel;
+    scan_diff = kernels[kernel];
+    chosen = 1;
+    return 0;
+}
+
+/*
+ * Pick the fastest kernel the processor can run, unless one was
+ * picked already.
+ */
+void scan_setup(void) {
+    int k;
+    if (chosen) return;
+    for (k = SCAN_KERNELS - 1; k > SCAN_SCALAR; --k) {
+        if (scan_use(k) == 0) return;
+    }
+    scan_use(SCAN_SCALAR);
+}
@@ -0,0 +1,37 @@
+/*
+ * Comparing rows of cells, for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stdint.h>
+
+/*
+ * The ways cells can be compared, from the slowest. The vector
+ * ones are only there on x86 processors that have them.
+ */
+enum scan_kernel {
+    SCAN_SCALAR, SCAN_SSE2, SCAN_AVX2, SCAN_KERNELS
+};
+
+extern const char *scan_kernel_names[SCAN_KERNELS];
+extern enum scan_kernel scan_kernel;
+
+/*
+ * Compare n <= 64 cells of a with those of b, setting bit k of the
+ * result where a[k] and b[k] differ.
+ *
+ * Between two frames, that is where the cells changed. Comparing
+ * a row with itself one cell on gives the boundaries of its runs:
+ * bit k of scan_diff(cells, cells + 1, n - 1) is set where cell k
+ * is the last one of a run.
+ */
+extern uint64_t (*scan_diff)(const char *a, const char *b, int n);
+
+int scan_available(enum scan_kernel kernel);
+int scan_use(enum scan_kernel kernel);
+void scan_setup(void);
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Benchmark for the stages a frame of pride-nyancat goes through.
+ *
+ * For every terminal type, way of collapsing runs (RLE mode) and a
+ * range of terminal sizes, times:
+ *
+ *   tail     composing the cells left of the frame, the rainbow
+ *            tail and the background around it
+ *   frame    looking up the cells of the animation frame itself
+ *   compose  composing the cells of a whole frame, both of the above
+ *   encode   encoding a composed frame in full
+ *   delta    encoding the change from the frame before
+ *   cache    getting a frame and its delta from the frame cache,
+ *            the way the render thread fills the ring
+ *   output   writing what is sent for each frame, to /dev/null
+ *
+ * in nanoseconds and, on x86, processor cycles (the time stamp
+ * counter) per cell the stage covers (the part of the viewport left
+ * of the frame for tail, the part on it for frame, all of it for the
+ * others), and how many bytes a frame comes to where the stage makes
+ * any. Stages that cover no cells at a size are left
+ * empty. Each stage is timed for 50 ms, or as many milliseconds as
+ * given. The results go to standard output as CSV, or as JSON with
+ * json as the argument, so they can be kept and compared between
+ * releases:
+ *
+ *     ./stage-bench [csv|json] [ms]
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "flags.h"
+#include "render.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define cycles() __rdtsc()
+#else
+#define cycles() 0ull
+#endif
+
+/* Each stage is repeated over all frames for at least this long */
+static double bench_ns = 50000000.0;
+
+enum stage {
+    TAIL, FRAME, COMPOSE, ENCODE, DELTA, LOOKUP, OUTPUT, STAGES
+};
+
+static const char *stage_names[] = {"tail", "frame", "compose", "encode", "delta", "cache", "output"};
+static const char *mode_names[] = {"truecolor", "256", "16"};
+static const char *rle_names[] = {"none", "ech", "rep"};
+
+static const struct {
+    int columns;
+    int rows;
+} sizes[] = {{40, 24}, {80, 24}, {132, 43}, {200, 60}, {300, 90}, {400, 120}};
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * The viewport of the whole frame, and the part of it a stage covers.
+ * Returns the cells in that part.
+ */
+static int whole[4];
+
+static size_t stage_viewport(enum stage stage) {
+    min_row = whole[0];
+    max_row = whole[1];
+    min_col = whole[2];
+    max_col = whole[3];
+    if (stage == TAIL) {
+        if (max_col > 0) max_col = 0;
+    } else if (stage == FRAME) {
+        if (min_row < 0) min_row = 0;
+        if (max_row > FRAME_HEIGHT) max_row = FRAME_HEIGHT;
+        if (min_col < 0) min_col = 0;
+        if (max_col > FRAME_WIDTH) max_col = FRAME_WIDTH;
+    }
+    if (max_row <= min_row || max_col <= min_col) return 0;
+    return (size_t) (max_row - min_row) * (max_col - min_col);
+}
+
+/*
+ * Go through every frame once in a stage, returning the bytes
+ * it came to.
+ */
+static size_t run_stage(enum stage stage, struct frame_cache *cache, struct buffer *out, int fd) {
+    size_t cells = (size_t) cache->width * cache->height, bytes = 0, i;
+    for (i = 0; i < cache->count; ++i) {
+        size_t prev = (i + cache->count - 1) % cache->count;
+        const char *data;
+        size_t len;
+        out->len = 0;
+        switch (stage) {
+            case TAIL:
+            case FRAME:
+                /* Into the scratch space, the cached frames are needed as they are */
+                compose_frame(out->data, i);
+                break;
+            case COMPOSE:
+                compose_frame(cache->grid + i * cells, i);
+                break;
+            case ENCODE:
+                encode_frame(out, cache->grid + i * cells, cache->width, cache->height);
+                bytes += out->len;
+                break;
+            case DELTA:
+                encode_delta(out, cache->grid + prev * cells, cache->grid + i * cells,
+                        cache->width, cache->height);
+                bytes += out->len;
+                break;
+            case LOOKUP:
+                /* Both ways of sending the frame go into the slot, the delta is what gets sent */
+                cache_lookup(cache, -1, i, &data, &len);
+                buffer_append(out, data, len);
+                if (!cache_lookup(cache, prev, i, &data, &len)) {
+                    buffer_append(out, data, len);
+                }
+                bytes += len;
+                break;
+            case OUTPUT:
+                cache_lookup(cache, prev, i, &data, &len);
+                if (write(fd, data, len) < 0) {
+                    perror("write");
+                    exit(1);
+                }
+                bytes += len;
+                break;
+            default:
+                break;
+        }
+    }
+    return bytes;
+}
+
+int main(int argc, char **argv) {
+    const char *format = argc > 1 ? argv[1] : "csv";
+    int json = !strcmp(format, "json");
+    char stripes[RAINBOW_ROWS + 3];
+    struct frame_cache cache = {0};
+    struct buffer out = {0};
+    int fd = open("/dev/null", O_WRONLY);
+    int mode, rle, s, first = 1;
+    size_t k;
+
+    if (argc > 2) bench_ns = atof(argv[2]) * 1e6;
+    if (fd < 0 || (!json && strcmp(format, "csv")) || bench_ns <= 0) {
+        fprintf(stderr, "usage: %s [csv|json] [ms]\n", argv[0]);
+        return 1;
+    }
+    flag_rainbow(&flag_table[G], stripes);
+    select_rainbow(stripes);
+
+    if (json) {
+        printf("[\n");
+    } else {
+        printf("stage,mode,rle,columns,rows,cells,ns_per_cell,cycles_per_cell,bytes_per_frame\n");
+    }
+    for (mode = 0; mode < 3; ++mode) {
+        compile_palette(&flag_table[G], mode);
+        for (rle = RLE_NONE; rle <= RLE_REP; ++rle) {
+            rle_mode = rle;
+            for (k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+                /* The viewport main() picks for a terminal of this size */
+                int across = cells_across(sizes[k].columns), down = cells_down(sizes[k].rows - 1);
+                whole[0] = (FRAME_HEIGHT - down) / 2;
+                whole[1] = (FRAME_HEIGHT + down) / 2;
+                whole[2] = (FRAME_WIDTH - across) / 2;
+                whole[3] = (FRAME_WIDTH + across) / 2;
+                stage_viewport(COMPOSE);
+                cache_build(&cache);
+                buffer_reserve(&out, (size_t) cache.width * cache.height);
+
+                for (s = 0; s < STAGES; ++s) {
+                    size_t cells = stage_viewport(s), bytes = 0;
+                    double start = now(), elapsed = 0, ns = 0, per_cycle = 0;
+                    unsigned long long started = cycles(), ticks;
+                    long passes = 0;
+                    while (cells && (elapsed = now() - start) < bench_ns) {
+                        bytes = run_stage(s, &cache, &out, fd);
+                        passes++;
+                    }
+                    ticks = cycles() - started;
+                    stage_viewport(COMPOSE);
+
+                    if (passes) {
+                        ns = elapsed / ((double) passes * cache.count * cells);
+                        per_cycle = ticks / ((double) passes * cache.count * cells);
+                    }
+                    double per_frame = (double) bytes / cache.count;
+                    int has_bytes = passes && s > COMPOSE;
+                    if (json) {
+                        printf("%s  {\"stage\": \"%s\", \"mode\": \"%s\", \"rle\": \"%s\", "
+                                "\"columns\": %d, \"rows\": %d, \"cells\": %zu, \"ns_per_cell\": ",
+                                first ? "" : ",\n", stage_names[s], mode_names[mode], rle_names[rle],
+                                sizes[k].columns, sizes[k].rows, cells);
+                        if (passes) {
+                            printf("%.4f", ns);
+                        } else {
+                            printf("null");
+                        }
+                        if (passes && ticks) {
+                            printf(", \"cycles_per_cell\": %.3f", per_cycle);
+                        } else {
+                            printf(", \"cycles_per_cell\": null");
+                        }
+                        if (has_bytes) {
+                            printf(", \"bytes_per_frame\": %.1f}", per_frame);
+                        } else {
+                            printf(", \"bytes_per_frame\": null}");
+                        }
+                    } else {
+                        printf("%s,%s,%s,%d,%d,%zu,", stage_names[s], mode_names[mode], rle_names[rle],
+                                sizes[k].columns, sizes[k].rows, cells);
+                        if (passes) printf("%.4f", ns);
+                        printf(",");
+                        if (passes && ticks) printf("%.3f", per_cycle);
+                        printf(",");
+                        if (has_bytes) printf("%.1f", per_frame);
+                        printf("\n");
+                    }
+                    first = 0;
+                    fflush(stdout);
+                }
+            }
+        }
+    }
+    if (json) printf("\n]\n");
+
+    cache_free(&cache);
+    buffer_free(&out);
+    close(fd);
+    return 0;
+}
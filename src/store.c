@@ -0,0 +1,498 @@
+/*
+ * Keeping encoded frames around between runs, for pride-nyancat.
+ *
+ * The frames only depend on what cache_key() hashes, so once built
+ * they are written to a file named after the key, and later runs
+ * map that file instead of building them again. Files that don't
+ * check out (wrong version, wrong key, bad checksum) are ignored
+ * and rebuilt. Files that weren't used for a while are removed when
+ * saving, and the least recently used ones while there are too many.
+ *
+ * The same layout is also published in shared memory, for other
+ * copies running at the same time to use without building or
+ * keeping frames of their own. The first copy to create the object
+ * builds the frames, the others wait for it. Every copy using the
+ * object holds a shared flock() on it, and the last one to let go
+ * removes it, so objects only stay around while they are in use.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "store.h"
+
+/*
+ * Stored files not used for this many seconds are removed, and the
+ * least recently used ones while together they take up more than
+ * STORE_MAX_BYTES.
+ */
+#define STORE_MAX_AGE   (30 * 24 * 60 * 60)
+#define STORE_MAX_BYTES (64 << 20)
+
+/*
+ * Longest a copy waits for another one to finish publishing
+ * frames, before building its own.
+ */
+#define SHARED_WAIT_MS 1000
+
+/*
+ * The file or shared memory object currently lent to a frame
+ * cache. For shared memory, mapped_fd stays open to hold the lock,
+ * and mapped_name is what it was published as.
+ */
+static void *mapped;
+static size_t mapped_size;
+static int mapped_fd = -1;
+static char mapped_name[64];
+
+/*
+ * A shared memory object this copy created and is to publish
+ * frames in, holding a shared lock, or -1.
+ */
+static int claimed_fd = -1;
+static char claimed_name[64];
+
+static void store_path(char *path, size_t size, const char *dir, uint64_t key) {
+    snprintf(path, size, "%s/%016llx.frames", dir, (unsigned long long) key);
+}
+
+/*
+ * Checksum of the frames, deltas and cells a header describes.
+ */
+static uint64_t store_checksum(const struct store_header *h, const char *data, const char *deltas,
+        const char *grid) {
+    uint64_t sum = hash_bytes(h->key, data, h->data_len);
+    sum = hash_bytes(sum, deltas, h->deltas_len);
+    return hash_bytes(sum, grid, h->grid_len);
+}
+
+/*
+ * Whether a mapped file holds frames for key, all there and intact.
+ */
+static int store_valid(const struct store_header *h, size_t size, uint64_t key) {
+    size_t k;
+
+    if (size < sizeof(*h) || memcmp(h->magic, STORE_MAGIC, 8) || h->version != STORE_VERSION ||
+            h->header_size != sizeof(*h) || h->key != key || h->size != size) {
+        return 0;
+    }
+    if (h->count == 0 || h->count > MAX_FRAMES || h->width < 0 || h->height < 0 ||
+            h->grid_len != (uint64_t) h->width * h->height * h->count ||
+            h->data_len + h->deltas_len + h->grid_len != size - sizeof(*h)) {
+        return 0;
+    }
+    for (k = 0; k < h->count; ++k) {
+        if (h->offset[k] > h->offset[k + 1] || h->delta_offset[k] > h->delta_offset[k + 1]) return 0;
+    }
+    if (h->offset[h->count] != h->data_len || h->delta_offset[h->count] > h->deltas_len) return 0;
+    return store_checksum(h, (const char *) (h + 1), (const char *) (h + 1) + h->data_len,
+            (const char *) (h + 1) + h->data_len + h->deltas_len) == h->checksum;
+}
+
+/*
+ * Remove a shared memory object, if its name still refers to it
+ * and not to a newer one published after it went.
+ */
+static void unlink_shared(int fd, const char *name) {
+    struct stat mine, named;
+    int other = shm_open(name, O_RDONLY, 0);
+
+    if (other < 0) return;
+    if (fstat(fd, &mine) == 0 && fstat(other, &named) == 0 &&
+            mine.st_dev == named.st_dev && mine.st_ino == named.st_ino) {
+        shm_unlink(name);
+    }
+    close(other);
+}
+
+/*
+ * Let go of a shared memory object, removing it if no other copy
+ * holds a lock on it anymore.
+ */
+static void release_shared(int fd, const char *name) {
+    if (fd < 0) return;
+    if (flock(fd, LOCK_EX | LOCK_NB) == 0) unlink_shared(fd, name);
+    close(fd);
+}
+
+/*
+ * Let go of what was lent to a frame cache, once the cache
+ * doesn't use it anymore.
+ */
+void store_detach(void) {
+    if (mapped) munmap(mapped, mapped_size);
+    mapped = NULL;
+    release_shared(mapped_fd, mapped_name);
+    mapped_fd = -1;
+}
+
+/*
+ * Map stored frames for key from an open file or shared memory
+ * object, and lend them to a cache. Returns -1 if they don't check
+ * out, leaving the cache as it was. Closes fd either way, unless
+ * name is given: then fd is a shared memory object that stays open
+ * for its lock while lent, and is released when it isn't.
+ */
+static int store_lend(struct frame_cache *cache, int fd, uint64_t key, const char *name) {
+    struct stat st;
+    void *base;
+    size_t k;
+
+    if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(struct store_header) ||
+            (base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        if (name) {
+            release_shared(fd, name);
+        } else {
+            close(fd);
+        }
+        return -1;
+    }
+    const struct store_header *h = base;
+    if (!store_valid(h, st.st_size, key)) {
+        munmap(base, st.st_size);
+        if (name) {
+            release_shared(fd, name);
+        } else {
+            close(fd);
+        }
+        return -1;
+    }
+
+    cache_free(cache);
+    const char *p = (const char *) (h + 1);
+    cache->data.data = (char *) p;
+    cache->data.len = h->data_len;
+    cache->deltas.data = (char *) p + h->data_len;
+    cache->deltas.len = h->deltas_len;
+    cache->grid = (char *) p + h->data_len + h->deltas_len;
+    for (k = 0; k <= h->count; ++k) {
+        cache->offset[k] = h->offset[k];
+        cache->delta_offset[k] = h->delta_offset[k];
+    }
+    cache->count = h->count;
+    cache->width = h->width;
+    cache->height = h->height;
+    cache->rows_down = h->rows_down;
+    cache->min_row = h->min_row;
+    cache->min_col = h->min_col;
+    cache->max_col = h->max_col;
+    cache->scale = h->scale;
+    cache->borrowed = 1;
+
+    /* Nothing points into what was lent before anymore */
+    if (mapped) munmap(mapped, mapped_size);
+    release_shared(mapped_fd, mapped_name);
+    mapped = base;
+    mapped_size = st.st_size;
+    mapped_fd = -1;
+    if (name) {
+        mapped_fd = fd;
+        snprintf(mapped_name, sizeof(mapped_name), "%s", name);
+    } else {
+        close(fd);
+    }
+    return 0;
+}
+
+/*
+ * Lend the stored frames for the current settings to a cache, if
+ * there are any in dir. Returns -1 if not, leaving the cache as it
+ * was.
+ */
+int store_load(struct frame_cache *cache, const char *dir) {
+    uint64_t key = cache_key();
+    char path[4096];
+    int fd;
+
+    store_path(path, sizeof(path), dir, key);
+    fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+    /* Mark it as used, so it is the last to be pruned */
+    futimens(fd, NULL);
+    return store_lend(cache, fd, key, NULL);
+}
+
+/*
+ * Make a directory and any missing parents.
+ */
+static int make_dirs(const char *dir) {
+    char path[4096];
+    char *p;
+
+    snprintf(path, sizeof(path), "%s", dir);
+    for (p = path + 1; *p; ++p) {
+        if (*p == '/') {
+            *p = '\0';
+            if (mkdir(path, 0700) < 0 && errno != EEXIST) return -1;
+            *p = '/';
+        }
+    }
+    return mkdir(path, 0700) < 0 && errno != EEXIST ? -1 : 0;
+}
+
+struct stored_file {
+    char name[64];
+    time_t used;
+    off_t size;
+};
+
+static int most_recent_first(const void *a, const void *b) {
+    time_t x = ((const struct stored_file *) a)->used, y = ((const struct stored_file *) b)->used;
+    return x < y ? 1 : x > y ? -1 : 0;
+}
+
+/*
+ * Remove stored files from dir that weren't used for STORE_MAX_AGE,
+ * then the least recently used ones beyond STORE_MAX_BYTES. The one
+ * named keep, just saved, stays. Temporary files a killed run left
+ * behind go after a day.
+ */
+static void store_prune(const char *dir, const char *keep) {
+    struct stored_file *files = NULL;
+    size_t count = 0, size = 0, k;
+    off_t total = 0;
+    time_t now = time(NULL);
+    struct dirent *entry;
+    char path[4096];
+    DIR *d = opendir(dir);
+
+    if (!d) return;
+    while ((entry = readdir(d))) {
+        const char *suffix = strstr(entry->d_name, ".frames");
+        struct stat st;
+        if (!suffix || strlen(entry->d_name) >= sizeof(files->name)) continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+        if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) continue;
+        if (suffix[7] ? now - st.st_mtime > 24 * 60 * 60 : now - st.st_mtime > STORE_MAX_AGE) {
+            unlink(path);
+            continue;
+        }
+        if (suffix[7] || !strcmp(entry->d_name, keep)) {
+            total += st.st_size;
+            continue;
+        }
+        if (count == size) {
+            struct stored_file *more = realloc(files, (size = size ? 2 * size : 16) * sizeof(*files));
+            if (!more) break;
+            files = more;
+        }
+        snprintf(files[count].name, sizeof(files[count].name), "%s", entry->d_name);
+        files[count].used = st.st_mtime;
+        files[count].size = st.st_size;
+        count++;
+    }
+    closedir(d);
+
+    qsort(files, count, sizeof(*files), most_recent_first);
+    for (k = 0; k < count; ++k) {
+        total += files[k].size;
+        if (total > STORE_MAX_BYTES) {
+            snprintf(path, sizeof(path), "%s/%s", dir, files[k].name);
+            unlink(path);
+        }
+    }
+    free(files);
+}
+
+/*
+ * Fill in the header for the frames in a cache, built for key.
+ */
+static void fill_header(struct store_header *h, const struct frame_cache *cache, uint64_t key) {
+    size_t k;
+
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, STORE_MAGIC, 8);
+    h->version = STORE_VERSION;
+    h->header_size = sizeof(*h);
+    h->key = key;
+    h->count = cache->count;
+    h->width = cache->width;
+    h->height = cache->height;
+    h->rows_down = cache->rows_down;
+    h->min_row = cache->min_row;
+    h->min_col = cache->min_col;
+    h->max_col = cache->max_col;
+    h->scale = cache->scale;
+    h->data_len = cache->data.len;
+    h->deltas_len = cache->deltas.len;
+    h->grid_len = (uint64_t) cache->width * cache->height * cache->count;
+    h->size = sizeof(*h) + h->data_len + h->deltas_len + h->grid_len;
+    for (k = 0; k <= cache->count; ++k) {
+        h->offset[k] = cache->offset[k];
+        h->delta_offset[k] = cache->delta_offset[k];
+    }
+    h->checksum = store_checksum(h, cache->data.data, cache->deltas.data, cache->grid);
+}
+
+/*
+ * Store the frames a cache was just built with in dir, for the next
+ * run. Frames this copy published are written from where they were
+ * published to. They go to a temporary file first, renamed into
+ * place once complete, so other runs never see half a file.
+ */
+int store_save(const struct frame_cache *cache, const char *dir) {
+    struct store_header h;
+    char path[4096], tmp[sizeof(path) + 8];
+    size_t grid_len = (size_t) cache->width * cache->height * cache->count;
+    FILE *f;
+    int fd, ok;
+
+    if (!cache->count) return -1;
+    fill_header(&h, cache, cache_key());
+
+    if (make_dirs(dir) < 0) return -1;
+    store_path(path, sizeof(path), dir, h.key);
+    snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path);
+    fd = mkstemp(tmp);
+    if (fd < 0) return -1;
+    f = fdopen(fd, "wb");
+    if (!f) {
+        close(fd);
+        unlink(tmp);
+        return -1;
+    }
+    ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+            fwrite(cache->data.data, 1, cache->data.len, f) == cache->data.len &&
+            fwrite(cache->deltas.data, 1, cache->deltas.len, f) == cache->deltas.len &&
+            fwrite(cache->grid, 1, grid_len, f) == grid_len;
+    if (fclose(f) != 0 || !ok || rename(tmp, path) < 0) {
+        unlink(tmp);
+        return -1;
+    }
+    store_prune(dir, strrchr(path, '/') + 1);
+    return 0;
+}
+
+/*
+ * Name of the shared memory object for the current settings. Only
+ * copies running as the same user share frames, as anyone could
+ * otherwise put escape sequences of their choice on their screens.
+ * The name is kept short for systems that only allow 31 characters.
+ */
+static uint64_t shared_name(char *name, size_t size) {
+    uid_t uid = getuid();
+    uint64_t key = cache_key();
+    snprintf(name, size, "/nyancat.%016llx", (unsigned long long) hash_bytes(key, &uid, sizeof(uid)));
+    return key;
+}
+
+/*
+ * Wait for the frames in a shared memory object to be complete,
+ * which they are once the magic number is in. Returns -1 if that
+ * doesn't happen in time.
+ */
+static int wait_published(int fd) {
+    struct timespec pause = {0, 2000000};
+    char magic[8];
+    int waited;
+
+    for (waited = 0; waited <= SHARED_WAIT_MS; waited += 2) {
+        if (pread(fd, magic, sizeof(magic), 0) == sizeof(magic) && !memcmp(magic, STORE_MAGIC, 8)) {
+            return 0;
+        }
+        nanosleep(&pause, NULL);
+    }
+    return -1;
+}
+
+/*
+ * Lend the frames another copy published for the current settings
+ * to a cache, waiting for them if they are still being built.
+ * Returns 0 if they were lent. Otherwise tries to become the copy
+ * that builds and publishes them, returning 1 if it did (call
+ * store_publish() once the frames are built), or -1 if another
+ * copy is taking too long and this one should build its own.
+ *
+ * An object that never got its frames and that nobody holds a lock
+ * on was left by a copy that died on the way, and is replaced.
+ */
+int store_attach(struct frame_cache *cache) {
+    char name[64];
+    uint64_t key = shared_name(name, sizeof(name));
+    struct stat st;
+    int attempt, fd;
+
+    release_shared(claimed_fd, claimed_name);
+    claimed_fd = -1;
+    for (attempt = 0; attempt < 3; ++attempt) {
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            /* Nobody else is publishing these, so this copy will */
+            flock(fd, LOCK_SH);
+            claimed_fd = fd;
+            snprintf(claimed_name, sizeof(claimed_name), "%s", name);
+            return 1;
+        }
+        if (errno != EEXIST) return -1;
+
+        fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) continue;
+        if (fstat(fd, &st) < 0 || st.st_uid != getuid()) {
+            close(fd);
+            return -1;
+        }
+        if (wait_published(fd) == 0) {
+            flock(fd, LOCK_SH);
+            return store_lend(cache, fd, key, name) == 0 ? 0 : -1;
+        }
+        if (flock(fd, LOCK_EX | LOCK_NB) < 0) {
+            /* Its creator is still at it */
+            close(fd);
+            return -1;
+        }
+        unlink_shared(fd, name);
+        close(fd);
+    }
+    return -1;
+}
+
+/*
+ * Publish the frames in a cache in the object store_attach()
+ * created, then switch the cache over to the published ones, so
+ * this copy doesn't keep frames of its own either.
+ *
+ * The magic number goes in last, so copies waiting for the frames
+ * only take them once they are all there.
+ */
+int store_publish(struct frame_cache *cache) {
+    struct store_header h;
+    char *base;
+    int fd = claimed_fd;
+
+    claimed_fd = -1;
+    if (fd < 0) return -1;
+    if (!cache->count) {
+        release_shared(fd, claimed_name);
+        return -1;
+    }
+    fill_header(&h, cache, cache_key());
+    if (ftruncate(fd, h.size) < 0 ||
+            (base = mmap(NULL, h.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        /* Nobody can use it, and the copies waiting for it see it's no longer locked */
+        release_shared(fd, claimed_name);
+        return -1;
+    }
+    memcpy(base, &h, sizeof(h));
+    memset(base, 0, sizeof(h.magic));
+    memcpy(base + sizeof(h), cache->data.data, h.data_len);
+    if (h.deltas_len) memcpy(base + sizeof(h) + h.data_len, cache->deltas.data, h.deltas_len);
+    memcpy(base + sizeof(h) + h.data_len + h.deltas_len, cache->grid, h.grid_len);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(base, STORE_MAGIC, sizeof(h.magic));
+    munmap(base, h.size);
+    return store_lend(cache, fd, h.key, claimed_name);
+}
@@ -0,0 +1,53 @@
+/*
+ * Keeping encoded frames around between runs, for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef STORE_H
+#define STORE_H
+
+#include <stdint.h>
+
+#include "render.h"
+
+#define STORE_MAGIC "PRIDECAT"
+
+/*
+ * Bumped whenever the layout below changes.
+ */
+#define STORE_VERSION 1
+
+/*
+ * Layout of a stored frame cache: this header, then the full
+ * frames, the deltas and the composed cells of every frame, back
+ * to back. Offsets are as in struct frame_cache.
+ */
+struct store_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;   /* sizeof(struct store_header), which differs between ABIs */
+    uint64_t key;           /* cache_key() the frames were built for */
+    uint64_t checksum;      /* Of everything after the header */
+    uint64_t size;          /* Of everything, header included */
+    uint64_t count;
+    int32_t width;
+    int32_t height;
+    int32_t rows_down;
+    int32_t min_row;
+    int32_t min_col;
+    int32_t max_col;
+    double scale;
+    uint64_t data_len;
+    uint64_t deltas_len;
+    uint64_t grid_len;
+    uint64_t offset[MAX_FRAMES + 1];
+    uint64_t delta_offset[MAX_FRAMES + 1];
+};
+
+int store_load(struct frame_cache *cache, const char *dir);
+int store_save(const struct frame_cache *cache, const char *dir);
+int store_attach(struct frame_cache *cache);
+int store_publish(struct frame_cache *cache);
+void store_detach(void);
+
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Asking the terminal what it supports, for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#define _XOPEN_SOURCE 700
+#define _DARWIN_C_SOURCE 1
+
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "terminal.h"
+
+/*
+ * The queries, in the order they are answered. Every terminal answers
+ * primary device attributes, so that one goes last: once its reply is
+ * in, everything the terminal is going to say has been said.
+ */
+static const char queries[] =
+        "\033[>0q"                  /* XTVERSION: name and version */
+        "\033P+q524742\033\\"       /* XTGETTCAP RGB: truecolor */
+        "\033P+q5463\033\\"         /* XTGETTCAP Tc: truecolor, as tmux calls it */
+        "\033P+q726570\033\\"       /* XTGETTCAP rep: repeat character */
+        "\033P+q626365\033\\"       /* XTGETTCAP bce: background color erase */
+        "\033[?2026$p"              /* DECRQM: synchronized output */
+        "\033_Gi=31,s=1,v=1,a=q,t=d,f=24;AAAA\033\\"  /* Kitty graphics */
+        "\033[c";                   /* DA1: primary device attributes */
+
+/*
+ * Terminals known to repeat characters, for those that don't say so.
+ */
+static const char *rep_terminals[] = {"XTerm(", "foot(", "kitty(", NULL};
+
+void terminal_query(int fd_out) {
+    if (write(fd_out, queries, sizeof(queries) - 1) < 0) {
+        /* Nothing will come back, and the replies are waited for with a timeout anyway */
+    }
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/*
+ * Control sequence replies, without the leading ESC [.
+ */
+static void parse_csi(struct terminal_caps *caps, const char *seq, size_t len) {
+    char final = seq[len - 1];
+    char *end;
+
+    if (seq[0] != '?') return;
+    if (final == 'c') {
+        /* DA1: ?class;attribute;...c, sixel graphics is attribute 4 */
+        const char *p = seq + 1;
+        strtol(p, &end, 10);
+        while (*end == ';') {
+            p = end + 1;
+            if (strtol(p, &end, 10) == 4) caps->sixel = 1;
+        }
+        caps->answered = 1;
+    } else if (final == 'y' && !strncmp(seq, "?2026;", 6)) {
+        /* DECRPM: 1 or 2 if the mode is known, 0 or 4 if not usable */
+        long value = strtol(seq + 6, &end, 10);
+        caps->sync = value == 1 || value == 2;
+    }
+}
+
+/*
+ * Device control string replies, without the ESC P and the ESC \.
+ */
+static void parse_dcs(struct terminal_caps *caps, const char *seq, size_t len) {
+    if (len >= 2 && !strncmp(seq, ">|", 2)) {
+        size_t n = len - 2 < sizeof(caps->version) - 1 ? len - 2 : sizeof(caps->version) - 1;
+        int k;
+        memcpy(caps->version, seq + 2, n);
+        caps->version[n] = '\0';
+        for (k = 0; rep_terminals[k]; ++k) {
+            if (!strncmp(caps->version, rep_terminals[k], strlen(rep_terminals[k]))) caps->rep = 1;
+        }
+    } else if (len >= 3 && !strncmp(seq, "1+r", 3)) {
+        /* XTGETTCAP: hex encoded name, then = and the value if it has one */
+        char name[8];
+        size_t k, n = 0;
+        for (k = 3; k + 1 < len && seq[k] != '=' && seq[k] != ';' && n < sizeof(name) - 1; k += 2) {
+            int hi = hex_value(seq[k]), lo = hex_value(seq[k + 1]);
+            if (hi < 0 || lo < 0) return;
+            name[n++] = hi << 4 | lo;
+        }
+        name[n] = '\0';
+        if (!strcmp(name, "RGB") || !strcmp(name, "Tc")) caps->truecolor = 1;
+        if (!strcmp(name, "rep")) caps->rep = 1;
+        if (!strcmp(name, "bce")) caps->bce = 1;
+    }
+}
+
+/*
+ * Application program command replies, without the ESC _ and the ESC \.
+ */
+static void parse_apc(struct terminal_caps *caps, const char *seq, size_t len) {
+    if (len >= 3 && seq[0] == 'G' && !strncmp(seq + len - 3, ";OK", 3)) {
+        caps->kitty_graphics = 1;
+    }
+}
+
+/*
+ * Read replies until the device attributes come back or the deadline
+ * passes. Anything that isn't a reply, like keypresses, is dropped.
+ */
+void terminal_read_caps(struct terminal_caps *caps, int fd_in, struct clock *clock, uint64_t deadline) {
+    enum {GROUND, ESCAPE, CSI, STRING, STRING_END} state = GROUND;
+    char seq[256], kind = 0;
+    size_t len = 0;
+
+    memset(caps, 0, sizeof(*caps));
+    while (!caps->answered) {
+        struct pollfd pfd = {fd_in, POLLIN, 0};
+        uint64_t now = clock->now(clock);
+        char input[256];
+        ssize_t n, k;
+
+        if (now >= deadline || poll(&pfd, 1, (deadline - now) / 1000000u + 1) <= 0) break;
+        n = read(fd_in, input, sizeof(input));
+        if (n <= 0) break;
+        for (k = 0; k < n; ++k) {
+            char c = input[k];
+            switch (state) {
+                case GROUND:
+                    if (c == '\033') state = ESCAPE;
+                    break;
+                case ESCAPE:
+                    kind = c;
+                    len = 0;
+                    state = c == '[' ? CSI : (c == 'P' || c == '_') ? STRING : GROUND;
+                    break;
+                case CSI:
+                    if (len < sizeof(seq) - 1) seq[len++] = c;
+                    if (c >= 0x40 && c <= 0x7e) {
+                        seq[len] = '\0';
+                        parse_csi(caps, seq, len);
+                        state = GROUND;
+                    }
+                    break;
+                case STRING:
+                    if (c == '\033') {
+                        state = STRING_END;
+                    } else if (len < sizeof(seq) - 1) {
+                        seq[len++] = c;
+                    }
+                    break;
+                case STRING_END:
+                    seq[len] = '\0';
+                    if (kind == 'P') {
+                        parse_dcs(caps, seq, len);
+                    } else {
+                        parse_apc(caps, seq, len);
+                    }
+                    state = c == '\033' ? ESCAPE : GROUND;
+                    break;
+            }
+        }
+    }
+}
+
+/*
+ * Whether a compiled terminfo entry has bce, reading the booleans
+ * that follow the header and the names. bce is boolean 28 in the
+ * order ncurses and the other implementations share.
+ */
+#define TERMINFO_BCE 28
+
+static int entry_bce(const char *dir, const char *term) {
+    char path[4096];
+    unsigned char header[12 + 512 + TERMINFO_BCE + 1];
+    size_t n = 0;
+    int k;
+
+    /* Entries are filed under their first letter, or its hex code on macOS */
+    for (k = 0; k < 2 && !n; ++k) {
+        FILE *f;
+        if (k == 0) {
+            snprintf(path, sizeof(path), "%s/%c/%s", dir, term[0], term);
+        } else {
+            snprintf(path, sizeof(path), "%s/%02x/%s", dir, (unsigned char) term[0], term);
+        }
+        if (!(f = fopen(path, "rb"))) continue;
+        n = fread(header, 1, sizeof(header), f);
+        fclose(f);
+    }
+    if (n < 12) return -1;
+
+    int magic = header[0] | header[1] << 8;
+    int names = header[2] | header[3] << 8;
+    int bools = header[4] | header[5] << 8;
+    if ((magic != 0432 && magic != 01036) || names > 512) return -1;
+    return bools > TERMINFO_BCE && (size_t) (12 + names + TERMINFO_BCE) < n && header[12 + names + TERMINFO_BCE] == 1;
+}
+
+/*
+ * Look the terminal up in terminfo the way ncurses does: only in
+ * $TERMINFO if that is set, otherwise in ~/.terminfo, $TERMINFO_DIRS
+ * and the usual system directories. Returns whether the first entry
+ * found has bce, 0 if there is none.
+ */
+int terminfo_bce(const char *term) {
+    static const char *system_dirs[] = {"/etc/terminfo", "/lib/terminfo", "/usr/share/terminfo",
+            "/usr/lib/terminfo", NULL};
+    const char *env = getenv("TERMINFO"), *home = getenv("HOME"), *dirs = getenv("TERMINFO_DIRS");
+    char path[4096];
+    int k, found;
+
+    if (!term || !term[0] || strchr(term, '/')) return 0;
+    if (env) return entry_bce(env, term) == 1;
+    if (home) {
+        snprintf(path, sizeof(path), "%s/.terminfo", home);
+        if ((found = entry_bce(path, term)) >= 0) return found;
+    }
+    while (dirs && *dirs) {
+        size_t len = strcspn(dirs, ":");
+        snprintf(path, sizeof(path), "%.*s", (int) len, dirs);
+        if (len && (found = entry_bce(path, term)) >= 0) return found;
+        dirs += len + (dirs[len] == ':');
+    }
+    for (k = 0; system_dirs[k]; ++k) {
+        if ((found = entry_bce(system_dirs[k], term)) >= 0) return found;
+    }
+    return 0;
+}
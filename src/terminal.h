@@ -0,0 +1,38 @@
+/*
+ * Asking the terminal what it supports, for pride-nyancat.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <stdint.h>
+
+#include "pacing.h"
+
+/*
+ * Longest the replies are waited for, counted from when the queries
+ * went out. Terminals that answer at all do so well within this.
+ */
+#define QUERY_TIMEOUT_MS 100
+
+/*
+ * What the terminal said about itself. Everything stays 0 for
+ * terminals that don't answer.
+ */
+struct terminal_caps {
+    int answered;       /* Primary device attributes came back */
+    int rep;            /* Repeats the last character (REP) */
+    int bce;            /* Erases with the background color */
+    int sync;           /* Synchronized output, DEC mode 2026 */
+    int truecolor;      /* 24-bit colors */
+    int sixel;          /* Sixel graphics */
+    int kitty_graphics; /* Kitty graphics protocol */
+    char version[64];   /* Name and version (XTVERSION), if given */
+};
+
+void terminal_query(int fd_out);
+void terminal_read_caps(struct terminal_caps *caps, int fd_in, struct clock *clock, uint64_t deadline);
+int terminfo_bce(const char *term);
+
+#endif
@@ -0,0 +1,67 @@
+#!/bin/sh
+#
+# Byte and time budgets for pride-nyancat.
+#
+# Every case in budgets.txt is rendered without a terminal (-o), and
+# fails if the frames take more bytes on average than the budget
+# there allows. With -t (make check-time), it also fails if the frame
+# cache takes more milliseconds to build than its budget, the best of
+# three runs. That depends on the machine and how busy it is, so it
+# is left out of make check. The time budgets are loose enough for
+# slower machines; tighten them when making things faster.
+#
+# usage: tests/budgets.sh [-t] path/to/pride-nyancat
+#
+# See pride-nyancat.c for copyright and licensing information.
+
+time=0
+if [ "$1" = "-t" ]; then
+    time=1
+    shift
+fi
+bin=$1
+dir=$(dirname "$0")
+runs=1
+[ $time = 1 ] && runs="1 2 3"
+frames=24
+
+# Print the bytes per frame and the milliseconds the frame cache
+# took, for a terminal type and size
+measure() {
+    colors=$1
+    size=$2
+    shift 2
+    case $colors in
+        truecolor) term=xterm-256color colorterm=truecolor ;;
+        256) term=xterm-256color colorterm= ;;
+        16) term=ansi colorterm= ;;
+        *) echo "unknown colors $colors" >&2; return 1 ;;
+    esac
+    for run in $runs; do
+        env -i HOME=/nonexistent TERMINFO=/nonexistent TERM=$term COLORTERM=$colorterm "$bin" -o "$size" -f $frames -S "$@" 2>&1 >/dev/null
+    done | awk '
+        /^all frames:/ { bytes = $4 }
+        /^frame caches:/ { if (ms == "" || $4 < ms) ms = $4 }
+        END { print bytes, ms }'
+}
+
+failed=0
+cases=0
+while read -r max_bytes max_ms colors size opts; do
+    case $max_bytes in
+        ''|'#'*) continue ;;
+    esac
+    set -- $(measure $colors $size $opts)
+    cases=$((cases + 1))
+    if [ "$1" -gt "$max_bytes" ]; then
+        echo "FAIL: $colors $size $opts: $1 bytes/frame, budget $max_bytes"
+        failed=$((failed + 1))
+    fi
+    if [ $time = 1 ] && awk "BEGIN { exit !($2 > $max_ms) }"; then
+        echo "FAIL: $colors $size $opts: $2 ms to build the frames, budget $max_ms"
+        failed=$((failed + 1))
+    fi
+done < "$dir/budgets.txt"
+
+echo "budgets: $cases cases, $failed failed"
+[ $failed = 0 ]
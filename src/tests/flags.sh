@@ -0,0 +1,57 @@
+#!/bin/sh
+#
+# Flag file tests for pride-nyancat.
+#
+# A flags file with good and bad lines is read with -F. The good
+# flag has to be there, and every bad line has to be reported with
+# the file and line it is on.
+#
+# usage: tests/flags.sh path/to/pride-nyancat
+#
+# See pride-nyancat.c for copyright and licensing information.
+
+bin=$1
+file=$(mktemp)
+trap 'rm -f "$file" "$file.err"' EXIT
+
+cat > "$file" << 'EOF'
+# Stripes as they may be written
+good  e40303 ff8c00:4 #ffed00 # and a comment
+bad1  ff00ffzz 00ff00
+bad2  ff00ff12
+bad3  #ff00ff:x
+bad4  ff00ff:4x
+EOF
+
+failed=0
+cases=0
+
+# Render a frame of a flag from the file, keeping what was reported
+render() {
+    env -i HOME=/nonexistent TERMINFO=/nonexistent TERM=xterm-256color \
+        "$bin" -F "$file" -p "$1" -o 40x24 -f 1 -n > /dev/null 2> "$file.err"
+}
+
+cases=$((cases + 1))
+if ! render good; then
+    echo "FAIL: good: not loaded"
+    failed=$((failed + 1))
+fi
+
+for line in 3:ff00ffzz 4:ff00ff12 5:ff00ff:x 6:ff00ff:4x; do
+    cases=$((cases + 1))
+    n=${line%%:*}
+    if ! grep -q "^$file:$n: bad color #*${line#*:}\$" "$file.err"; then
+        echo "FAIL: line $n: not reported as a bad color"
+        failed=$((failed + 1))
+    fi
+done
+
+cases=$((cases + 1))
+if render bad2; then
+    echo "FAIL: bad2: loaded"
+    failed=$((failed + 1))
+fi
+
+echo "flags: $cases cases, $failed failed"
+[ $failed = 0 ]
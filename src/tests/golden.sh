@@ -0,0 +1,92 @@
+#!/bin/sh
+#
+# Golden output tests for pride-nyancat.
+#
+# Every case in golden.txt is rendered without a terminal (-o), and
+# the checksum and length of the output compared with the ones
+# recorded there. The output itself is kept, compressed, in golden/.
+# When a case fails, its output is left in failed/ and tests/vtdiff
+# shows where it differs from the one kept, byte and screen cell.
+#
+# After a change that is meant to alter the output, run it with -u
+# (or make update-golden) to record the new output, and check that
+# the lengths changed the way they should. Bump ENCODER_VERSION in
+# render.h too, so frames kept with -c are rebuilt.
+#
+# usage: tests/golden.sh [-u] path/to/pride-nyancat
+#
+# See pride-nyancat.c for copyright and licensing information.
+
+update=0
+if [ "$1" = "-u" ]; then
+    update=1
+    shift
+fi
+bin=$1
+dir=$(dirname "$0")
+frames=24
+
+# Render frames for a terminal type and size, with nothing from the
+# environment but what the terminal type needs, and no terminfo so that
+# the run-length mode picked by default is the same on every machine
+render() {
+    colors=$1
+    size=$2
+    shift 2
+    case $colors in
+        truecolor) term=xterm-256color colorterm=truecolor ;;
+        256) term=xterm-256color colorterm= ;;
+        16) term=ansi colorterm= ;;
+        *) echo "unknown colors $colors" >&2; return 1 ;;
+    esac
+    env -i HOME=/nonexistent TERMINFO=/nonexistent TERM=$term COLORTERM=$colorterm "$bin" -o "$size" -f $frames "$@"
+}
+
+failed=0
+cases=0
+out=$dir/golden.txt.new
+: > "$out"
+rm -rf "$dir/failed"
+mkdir -p "$dir/golden"
+while read -r sum len colors size opts; do
+    case $sum in
+        ''|'#'*)
+            echo "$sum${len:+ $len}${colors:+ $colors}${size:+ $size}${opts:+ $opts}" >> "$out"
+            continue
+            ;;
+    esac
+    # The case's name, like 256-100x40-G-gsextant
+    name=$colors-$size$(echo $opts | tr -d ' ')
+    kept=$dir/golden/$name.gz
+    render $colors $size $opts > "$out.output"
+    set -- $(cksum < "$out.output")
+    cases=$((cases + 1))
+    if [ "$1 $2" != "$sum $len" ] || [ ! -f "$kept" ]; then
+        failed=$((failed + 1))
+        if [ $update = 1 ]; then
+            gzip -9n < "$out.output" > "$kept"
+        else
+            echo "FAIL: $colors $size $opts: $2 bytes, checksum $1 (expected $len bytes, checksum $sum)"
+            mkdir -p "$dir/failed"
+            mv "$out.output" "$dir/failed/$name"
+            if [ -f "$kept" ]; then
+                gzip -dc < "$kept" > "$dir/failed/$name.expected"
+                "$dir/vtdiff" "$size" "$dir/failed/$name.expected" "$dir/failed/$name"
+            else
+                echo "  no output kept in $kept"
+            fi
+            echo "  the output is in $dir/failed/$name"
+        fi
+    fi
+    printf '%-10s %-7s %-9s %-7s %s\n' "$1" "$2" "$colors" "$size" "$opts" >> "$out"
+done < "$dir/golden.txt"
+rm -f "$out.output"
+
+if [ $update = 1 ]; then
+    mv "$out" "$dir/golden.txt"
+    echo "golden: $cases cases, $failed updated"
+    exit 0
+fi
+rm -f "$out"
+echo "golden: $cases cases, $failed failed"
+[ $failed = 0 ]
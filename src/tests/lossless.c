@@ -0,0 +1,498 @@
+/*
+ * Differential test for the pride-nyancat encoders.
+ *
+ * However frames are encoded (whole or as deltas, with runs collapsed
+ * by ECH or REP, in block characters, split into bands, dropped and
+ * caught up with), the terminal has to end up showing the animation.
+ * What it shows is worked out here on its own, cell by cell from the
+ * packed animation the way the original main() drew it, and scaled
+ * the documented way. What the encoders send is played on the screen
+ * model in vt.c, and every cell compared with that, along with the
+ * cursor and the color the counter line is drawn in.
+ *
+ * Cases are random settings, terminal sizes, resizes and sequences
+ * of frames, from a seed so that a failure can be repeated:
+ *
+ *     tests/lossless [cases [seed]]
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../flags.h"
+#include "../render.h"
+#include "vt.h"
+
+/* The animation as pack-frames wrote it, read here rather than through render.c */
+#include "../animation_packed.c"
+
+#define STEPS 40
+
+static uint64_t state;
+
+static unsigned next(unsigned n) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return (unsigned) ((state * 0x2545f4914f6cdd1dULL) >> 33) % n;
+}
+
+/*
+ * The settings of a case, and the terminal it is drawn on.
+ */
+struct setup {
+    int ttype;
+    int flag;
+    int fit;
+    int crop_width;     /* 0 for as wide as the terminal */
+    int crop_height;
+    int columns;
+    int rows;
+};
+
+static const char *ttype_names[] = {"truecolor", "256", "16"};
+static const char *glyph_names[] = {"spaces", "half", "quadrant", "sextant"};
+static const char *rle_names[] = {"none", "ech", "rep"};
+
+static void describe(const struct setup *s, unsigned long seed, int n) {
+    fprintf(stderr, "case %d (seed %lu): %s colors, flag %d, %dx%d, glyphs %s, runs %s, %s%s, "
+            "scale %s%.3f, crop %dx%d, %d threads\n", n, seed, ttype_names[s->ttype], s->flag,
+            s->columns, s->rows, glyph_names[glyph_mode], rle_names[rle_mode],
+            render_mode == RENDER_DELTA ? "delta" : "full",
+            clear_screen ? "" : ", no clear", s->fit ? "fit " : "", scale,
+            s->crop_width, s->crop_height, encode_threads);
+}
+
+/*
+ * The viewport for the terminal size, the same way main() works it out.
+ */
+static void fit_viewport(const struct setup *s) {
+    int across = cells_across(s->columns);
+    int down = cells_down(s->rows - 1);
+
+    if (s->fit && across > 0 && down > 0) {
+        double x = (double) across / FRAME_WIDTH, y = (double) down / FRAME_HEIGHT;
+        scale = x < y ? x : y;
+    }
+    int width = (int) (FRAME_WIDTH * scale + 0.5);
+    int height = (int) (FRAME_HEIGHT * scale + 0.5);
+    if (s->crop_width) across = s->crop_width;
+    if (s->crop_height) down = s->crop_height;
+    min_col = (width - across) / 2;
+    max_col = (width + across) / 2;
+    min_row = (height - down) / 2;
+    max_row = (height + down) / 2;
+}
+
+/*
+ * A terminal size, at least 1x2, mostly the usual sizes but now and
+ * then a big one. With keep set to 1 or 2, the columns or the rows
+ * stay as they were. Crops stay inside the terminal.
+ */
+static void pick_size(struct setup *s, int keep) {
+    int across, down;
+    if (keep != 1) s->columns = next(8) ? 1 + next(220) : 300 + next(101);
+    if (keep != 2) s->rows = next(8) ? 2 + next(70) : 90 + next(31);
+    across = cells_across(s->columns);
+    down = cells_down(s->rows - 1);
+    s->crop_width = across && next(6) == 0 ? 1 + next(across) : 0;
+    s->crop_height = down && next(6) == 0 ? 1 + next(down) : 0;
+}
+
+/*
+ * The flag's rainbow, top to bottom from the row before the tail, and
+ * the color each color index shows as on the screen.
+ */
+static char stripes[RAINBOW_ROWS + 3];
+static uint32_t shown[256];
+
+static char rainbow_cell(int n) {
+    return n >= 0 && n < (int) strlen(stripes) ? stripes[n] : ',';
+}
+
+/*
+ * Cell x, y of frame i of the animation, the way the original main()
+ * worked it out: the rainbow tail as a square wave left of the frame,
+ * background around the frame, and the frame itself, its rainbow
+ * cells marked with the rainbow cell they take.
+ */
+static char animation_cell(size_t i, int y, int x) {
+    char color;
+    if (y > 23 && y < 43 && x < 0) {
+        int mod_x = ((-x + 2) % 16) / 8;
+        if ((i / 2) % 2) {
+            mod_x = 1 - mod_x;
+        }
+        color = rainbow_cell(mod_x + y - 23);
+    } else if (x < 0 || y < 0 || y >= FRAME_HEIGHT || x >= FRAME_WIDTH) {
+        color = ',';
+    } else {
+        unsigned char pair = animation_rows[animation.rows[i * FRAME_HEIGHT + y]][x / 2];
+        color = animation_palette[x & 1 ? pair >> 4 : pair & 15];
+        if (color == '0' || color == '1') {
+            color = rainbow_cell(y - 23 + (color - '0'));
+        }
+    }
+    return color;
+}
+
+static int floor_of(double v) {
+    int n = (int) v;
+    return n > v ? n - 1 : n;
+}
+
+/*
+ * The cell at x, y of the scaled animation: the cell nearest its
+ * middle when scaling up, and the color most of the cells it covers
+ * have when scaling down, the one that got there first on a tie.
+ */
+static char scaled_cell(size_t i, int y, int x) {
+    int y0, y1, x0, x1, r, c, k, best = 0, distinct = 0, counts[64];
+    char seen[64], color = ',';
+
+    if (scale >= 1) {
+        return animation_cell(i, floor_of((y + 0.5) / scale), floor_of((x + 0.5) / scale));
+    }
+    y0 = floor_of(y / scale);
+    y1 = floor_of((y + 1) / scale);
+    x0 = floor_of(x / scale);
+    x1 = floor_of((x + 1) / scale);
+    if (y1 <= y0) y1 = y0 + 1;
+    if (x1 <= x0) x1 = x0 + 1;
+    for (r = y0; r < y1; ++r) {
+        for (c = x0; c < x1; ++c) {
+            char cell = animation_cell(i, r, c);
+            for (k = 0; k < distinct && seen[k] != cell; ++k);
+            if (k == distinct) {
+                seen[distinct] = cell;
+                counts[distinct++] = 0;
+            }
+            if (++counts[k] > best) {
+                best = counts[k];
+                color = cell;
+            }
+        }
+    }
+    return color;
+}
+
+/*
+ * Frame i in the current viewport, one color index per cell.
+ */
+static void reference_frame(char *grid, size_t i) {
+    int x, y;
+    for (y = min_row; y < max_row; ++y) {
+        for (x = min_col; x < max_col; ++x) {
+            *grid++ = scale == 1.0 ? animation_cell(i, y, x) : scaled_cell(i, y, x);
+        }
+    }
+}
+
+/*
+ * What a color escape shows on the screen, as the screen model has it.
+ */
+static void find_shown(void) {
+    int c;
+    for (c = 0; c < 256; ++c) {
+        struct vt vt;
+        vt_init(&vt, 1, 1);
+        if (colors[c]) vt_feed(&vt, colors[c], strlen(colors[c]));
+        shown[c] = vt.bg;
+        vt_free(&vt);
+    }
+}
+
+/*
+ * Block characters by code point, for each glyph mode. These are the
+ * characters the glyph modes are documented to use, listed again here
+ * rather than taken from render.c, so a mistake there shows up.
+ */
+static const unsigned half_blocks[4] = {0x20, 0x2580, 0x2584, 0x2588};
+static const unsigned quadrant_blocks[16] = {
+    0x20, 0x2598, 0x259d, 0x2580, 0x2596, 0x258c, 0x259e, 0x259b,
+    0x2597, 0x259a, 0x2590, 0x259c, 0x2584, 0x2599, 0x259f, 0x2588,
+};
+
+static int across_of[] = {1, 1, 2, 2}, down_of[] = {1, 2, 2, 3};
+
+static unsigned block(int pattern) {
+    if (glyph_mode == GLYPH_HALF) return half_blocks[pattern];
+    if (glyph_mode == GLYPH_QUADRANT) return quadrant_blocks[pattern];
+    if (pattern == 0) return 0x20;
+    if (pattern == 21) return 0x258c;
+    if (pattern == 42) return 0x2590;
+    if (pattern == 63) return 0x2588;
+    return 0x1fb00 + pattern - 1 - (pattern > 21) - (pattern > 42);
+}
+
+/*
+ * The pattern a character shows in the glyph mode, or -1.
+ */
+static int pattern_of(uint32_t ch) {
+    int k, count = 1 << (across_of[glyph_mode] * down_of[glyph_mode]);
+    if (ch == ' ') return 0;
+    for (k = 0; k < count; ++k) {
+        if (block(k) == ch) return k;
+    }
+    return -1;
+}
+
+/*
+ * The cells of the animation in a character cell, which start at x, y
+ * of grid, the colors among them, how many there are of each and
+ * which is the most common, if one is. Cells past the edge of the
+ * frame count as background.
+ */
+struct block_cells {
+    char cells[6];
+    char seen[6];
+    int counts[6];
+    int distinct;
+    int top;
+    int tied;
+};
+
+static void read_block(struct block_cells *b, const char *grid, int width, int height, int x, int y) {
+    int across = across_of[glyph_mode], n = across * down_of[glyph_mode], k, d;
+
+    b->distinct = b->top = b->tied = 0;
+    for (k = 0; k < n; ++k) {
+        int cx = x + k % across, cy = y + k / across;
+        b->cells[k] = cx < width && cy < height ? grid[(size_t) cy * width + cx] : ',';
+        for (d = 0; d < b->distinct && b->seen[d] != b->cells[k]; ++d);
+        if (d == b->distinct) {
+            b->seen[b->distinct] = b->cells[k];
+            b->counts[b->distinct++] = 0;
+        }
+        b->counts[d]++;
+    }
+    for (d = 1; d < b->distinct; ++d) {
+        if (b->counts[d] > b->counts[b->top]) b->top = d;
+    }
+    for (d = 0; d < b->distinct; ++d) {
+        if (d != b->top && b->counts[d] == b->counts[b->top]) b->tied = 1;
+    }
+}
+
+/*
+ * Whether a color is the one most cells of a block have, or one of
+ * the block's colors if none is.
+ */
+static int block_main_color(const struct block_cells *b, uint32_t color) {
+    int d;
+    if (!b->tied) return color == shown[(unsigned char) b->seen[b->top]];
+    for (d = 0; d < b->distinct; ++d) {
+        if (color == shown[(unsigned char) b->seen[d]]) return 1;
+    }
+    return 0;
+}
+
+/*
+ * Whether a character cell on the screen shows the cells of the
+ * animation in it. Where they are of more than two colors, every
+ * cell has to show one of them, and the cells in the color most of
+ * them have that color.
+ */
+static int shows_block(const struct vt_cell *cell, const struct block_cells *b) {
+    int pattern = pattern_of(cell->ch), n = across_of[glyph_mode] * down_of[glyph_mode], k, d;
+
+    if (pattern < 0) return 0;
+    for (k = 0; k < n; ++k) {
+        uint32_t color = pattern >> k & 1 ? cell->fg : cell->bg;
+        if (b->distinct <= 2 || (!b->tied && b->cells[k] == b->seen[b->top])) {
+            if (color != shown[(unsigned char) b->cells[k]]) return 0;
+        } else {
+            for (d = 0; d < b->distinct && color != shown[(unsigned char) b->seen[d]]; ++d);
+            if (d == b->distinct) return 0;
+        }
+    }
+    return 1;
+}
+
+/*
+ * Compare the frame on a screen with the animation, printing the
+ * first difference. The frame starts at the top left, and the cursor
+ * is left at the start of the line after it, for the counter line to
+ * be drawn on the color most of the last cell has.
+ */
+static int compare(struct vt *got, const char *grid, int width, int height, const char *what) {
+    int across = across_of[glyph_mode], down = down_of[glyph_mode];
+    int spaces = glyph_mode == GLYPH_SPACES, out_len = strlen(output);
+    int columns, rows, x, y, same = 1;
+    struct block_cells last = {{','}, {','}, {1}, 1, 0, 0};
+
+    if (spaces) {
+        columns = width * out_len;
+        rows = height;
+    } else {
+        columns = (width + across - 1) / across;
+        rows = (height + down - 1) / down;
+    }
+
+    if (columns > got->width || rows >= got->height) {
+        fprintf(stderr, "%s: a frame of %dx%d doesn't fit\n", what, columns, rows);
+        same = 0;
+    } else if (got->error[0]) {
+        fprintf(stderr, "%s: %s\n", what, got->error);
+        same = 0;
+    }
+    for (y = 0; y < rows && same; ++y) {
+        for (x = 0; x < columns && same; ++x) {
+            const struct vt_cell *a = vt_at(got, x, y);
+            if (spaces) {
+                char c = grid[(size_t) y * width + x / out_len];
+                same = a->ch == (unsigned char) output[x % out_len] && a->bg == shown[(unsigned char) c];
+                last.seen[0] = c;
+                if (!same) {
+                    fprintf(stderr, "%s: cell %d,%d is U+%04x on %07x, should be '%c' on %07x\n",
+                            what, x, y, (unsigned) a->ch, (unsigned) a->bg, output[x % out_len],
+                            (unsigned) shown[(unsigned char) c]);
+                }
+            } else {
+                read_block(&last, grid, width, height, x * across, y * down);
+                same = shows_block(a, &last);
+                if (!same) {
+                    fprintf(stderr, "%s: cell %d,%d is U+%04x %07x on %07x, which isn't what the animation has\n",
+                            what, x, y, (unsigned) a->ch, (unsigned) a->fg, (unsigned) a->bg);
+                }
+            }
+        }
+    }
+    if (same && (got->x != 0 || got->y != rows || (columns && !block_main_color(&last, got->bg)))) {
+        fprintf(stderr, "%s: left at %d,%d on %07x, should be 0,%d on %07x\n", what,
+                got->x, got->y, (unsigned) got->bg, rows, (unsigned) shown[(unsigned char) last.seen[last.top]]);
+        same = 0;
+    }
+    return same;
+}
+
+/*
+ * Fill the screen with something no frame shows, so that
+ * whatever a frame leaves out stands out.
+ */
+static void scribble(struct vt *vt) {
+    static const char junk[] = "\033[48;2;1;2;3m\033[2J\033[38;5;9m#~\033[4;7H??";
+    vt_feed(vt, junk, sizeof(junk) - 1);
+}
+
+static int run_case(int n, unsigned long seed) {
+    struct setup s;
+    struct frame_cache cache = {0};
+    char name[64];
+    char *grid = NULL;
+    const char *start;
+    struct vt screen, plain;
+    struct buffer direct = {0};
+    long shown = -1;
+    int step, ok = 1;
+    size_t i = 0;
+
+    memset(&s, 0, sizeof(s));
+    s.ttype = next(3);
+    s.flag = next(BUILTIN_FLAGS);
+    glyph_mode = next(4);
+    rle_mode = next(3);
+    clear_screen = next(8) != 0;
+    /* Deltas need the frame at the top, as main() knows */
+    render_mode = next(4) && clear_screen ? RENDER_DELTA : RENDER_FULL;
+    encode_threads = 1 + next(4);
+    s.fit = next(3) == 0;
+    scale = (double[]) {1.0, 1.0, 0.5, 1.5, 2.5, 0.37}[next(6)];
+    pick_size(&s, 0);
+
+    if (compile_palette(&flag_table[s.flag], s.ttype) < 0) {
+        fprintf(stderr, "no palette for terminal type %d\n", s.ttype);
+        return 0;
+    }
+    find_shown();
+    flag_rainbow(&flag_table[s.flag], stripes);
+    select_rainbow(stripes);
+    fit_viewport(&s);
+    cache_build(&cache);
+
+    vt_init(&screen, s.columns, s.rows);
+    scribble(&screen);
+    /* What main() sends first, the cursor put at the top for -e */
+    start = clear_screen ? "\033[?1049h\033[H\033[2J\033[?25l" : "\033[?1049h\033[H\033[s";
+    vt_feed(&screen, start, strlen(start));
+
+    for (step = 0; step < STEPS && ok; ++step) {
+        const char *data;
+        size_t len, cells;
+        long prev = shown;
+        int r = next(100), full;
+
+        if (r < 5) {
+            /* A new terminal size, sometimes only one way */
+            pick_size(&s, r < 3 ? r : 0);
+            vt_resize(&screen, s.columns, s.rows);
+            fit_viewport(&s);
+            cache_build(&cache);
+            prev = -1;
+        } else if (r < 6) {
+            /* Other colors for the same size, as when the terminal answers what it supports */
+            s.ttype = next(3);
+            rle_mode = next(3);
+            compile_palette(&flag_table[s.flag], s.ttype);
+            find_shown();
+            cache_build(&cache);
+            prev = -1;
+        } else if (r < 10) {
+            /* Sent in full, after the writer dropped a frame it had no delta for */
+            prev = -1;
+        }
+        i = r >= 10 && r < 20 ? next(cache.count) : (i + (shown >= 0)) % cache.count;
+        full = cache_lookup(&cache, prev, i, &data, &len);
+        vt_feed(&screen, data, len);
+        shown = i;
+
+        /* Dropped deltas are sent together with the next one, so the frame between isn't seen */
+        if (!full && next(6) == 0) continue;
+
+        cells = (size_t) cache.width * cache.height;
+        grid = realloc(grid, cells + 1);
+        reference_frame(grid, i);
+        snprintf(name, sizeof(name), "step %d, frame %zu %s", step, i,
+                full ? "in full" : prev == (long) ((i + cache.count - 1) % cache.count) ? "as delta" :
+                "as delta from another frame");
+        ok = compare(&screen, grid, cache.width, cache.height, name);
+
+        /* encode_frame() on its own, from the animation and a screen the frame doesn't start from */
+        if (ok && next(4) == 0) {
+            direct.len = 0;
+            encode_frame(&direct, grid, cache.width, cache.height);
+            vt_init(&plain, s.columns, s.rows);
+            vt_feed(&plain, direct.data, direct.len);
+            snprintf(name, sizeof(name), "step %d, frame %zu from encode_frame()", step, i);
+            ok = compare(&plain, grid, cache.width, cache.height, name);
+            vt_free(&plain);
+        }
+    }
+    if (!ok) describe(&s, seed, n);
+
+    vt_free(&screen);
+    buffer_free(&direct);
+    free(grid);
+    cache_free(&cache);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    int cases = argc > 1 ? atoi(argv[1]) : 150;
+    unsigned long seed = argc > 2 ? strtoul(argv[2], NULL, 10) : 1;
+    int n, failed = 0;
+
+    if (cases < 1) {
+        fprintf(stderr, "usage: %s [cases [seed]]\n", argv[0]);
+        return 1;
+    }
+    state = seed * 0x9e3779b97f4a7c15ULL + 1;
+    for (n = 0; n < cases && failed < 5; ++n) {
+        if (!run_case(n, seed)) failed++;
+    }
+    printf("lossless: %d cases, %d failed\n", n, failed);
+    return failed != 0;
+}
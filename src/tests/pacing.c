@@ -0,0 +1,162 @@
+/*
+ * Test for the frame pacer of pride-nyancat.
+ *
+ * pacer_wait() is driven on a clock that only pretends to sleep, and
+ * wakes up when a script says: on time, late, or before the deadline.
+ * Frames can also take a while to render in between. The deadlines
+ * the pacer gives up on and the mean and 99th percentile it reports
+ * are checked against what the script works out to.
+ *
+ *     tests/pacing
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../pacing.h"
+
+#define MS 1000000
+
+/*
+ * A virtual clock whose sleeps end at the deadline plus the next of
+ * a list of offsets, negative ones waking up early.
+ */
+struct script_clock {
+    struct clock clock;
+    const long *wakeups;
+    size_t count;
+    size_t next;
+};
+
+static uint64_t script_now(struct clock *clock) {
+    return clock->virtual_now;
+}
+
+static void script_sleep_until(struct clock *clock, uint64_t deadline) {
+    struct script_clock *script = (struct script_clock *) clock;
+    long offset = script->count ? script->wakeups[script->next++ % script->count] : 0;
+    uint64_t wake = deadline + offset;
+    if (wake > clock->virtual_now) {
+        clock->virtual_now = wake;
+    }
+}
+
+static void script_init(struct script_clock *script, const long *wakeups, size_t count) {
+    script->clock.now = script_now;
+    script->clock.sleep_until = script_sleep_until;
+    script->clock.virtual_now = 1000 * MS;
+    script->wakeups = wakeups;
+    script->count = count;
+    script->next = 0;
+}
+
+/*
+ * A run of frames: the wakeups, how long rendering takes before each
+ * wait (also repeated), and what should come of it.
+ */
+struct pacing_case {
+    const char *name;
+    long wakeups[4];
+    size_t wakeup_count;
+    long work[4];
+    size_t work_count;
+    int frames;
+    uint64_t skipped;       /* Deadlines given up on */
+    double mean_ms;         /* Reported mean period */
+    double p99_ms;          /* and 99th percentile jitter */
+    int on_deadline;        /* Whether every frame should go out right at a deadline */
+    int never_early;        /* and none before a whole period is up */
+};
+
+static const struct pacing_case cases[] = {
+    {"on time", {0}, 1, {2 * MS}, 1, 200, 0, 10.0, 0.0, 1, 1},
+    /* Only the first period is longer, the deadlines after it don't move */
+    {"late by 3 ms", {3 * MS}, 1, {0}, 1, 100, 0, 10.03, 3.0, 0, 1},
+    /* Later than a period: the frame after is already due and goes right away, catching up */
+    {"late by 12 ms", {12 * MS}, 1, {0}, 1, 100, 0, 10.02, 12.0, 0, 0},
+    /* Every other wakeup early: the pacer sleeps again rather than letting the frame out */
+    {"early by 4 ms", {-4 * MS, 0}, 2, {MS}, 1, 100, 0, 10.0, 0.0, 1, 1},
+    /*
+     * Every tenth frame takes 35 ms to render. The 2 deadlines it
+     * missed by a whole period are given up, it goes out 5 ms late,
+     * 35 ms after the frame before, and the frame after it only
+     * stays up the 5 ms left. Ten frames take twelve periods, but the
+     * run ends on a slow frame, without the short one after it.
+     */
+    {"slow frames", {0}, 1, {0}, 0, 100, 20, 12.05, 25.0, 0, 0},
+};
+
+static int run_case(const struct pacing_case *c) {
+    struct script_clock script;
+    struct pacer pacer;
+    uint64_t skipped = 0, start;
+    double mean, p99, requested;
+    unsigned long long reported;
+    char *text = NULL;
+    size_t text_size = 0;
+    FILE *report;
+    int frame, ok = 1;
+
+    script_init(&script, c->wakeups, c->wakeup_count);
+    pacer_start(&pacer, &script.clock, 10 * MS);
+    start = script.clock.virtual_now;
+    for (frame = 0; frame < c->frames; ++frame) {
+        uint64_t before, after;
+        if (c->work_count) {
+            script.clock.virtual_now += c->work[frame % c->work_count];
+        } else if (frame % 10 == 9) {
+            script.clock.virtual_now += 35 * MS;
+        }
+        before = pacer.last;
+        skipped += pacer_wait(&pacer);
+        after = script.clock.virtual_now;
+        if (c->never_early && after - before < 10 * MS) {
+            fprintf(stderr, "%s: frame %d went out after %.3f ms\n", c->name, frame, (after - before) / 1e6);
+            ok = 0;
+        }
+        if (c->on_deadline && (after - start) % (10 * MS)) {
+            fprintf(stderr, "%s: frame %d went out off the deadlines\n", c->name, frame);
+            ok = 0;
+        }
+    }
+
+    report = open_memstream(&text, &text_size);
+    if (!report) {
+        perror("open_memstream");
+        exit(1);
+    }
+    pacer_report(report, &pacer);
+    fclose(report);
+    if (sscanf(text, "frame period: %lf ms mean, %lf ms p99 jitter, %lf ms requested, %llu deadlines skipped",
+            &mean, &p99, &requested, &reported) != 4) {
+        fprintf(stderr, "%s: can't read the report: %s", c->name, text);
+        ok = 0;
+    } else if (skipped != c->skipped || reported != c->skipped || pacer.skipped != c->skipped) {
+        fprintf(stderr, "%s: %llu deadlines given up on, %llu reported, should be %llu\n", c->name,
+                (unsigned long long) skipped, reported, (unsigned long long) c->skipped);
+        ok = 0;
+    } else if (mean < c->mean_ms - 0.0005 || mean > c->mean_ms + 0.0005 ||
+            p99 < c->p99_ms - 0.0005 || p99 > c->p99_ms + 0.0005 || requested != 10.0) {
+        fprintf(stderr, "%s: reported %.3f ms mean and %.3f ms p99, should be %.3f and %.3f\n",
+                c->name, mean, p99, c->mean_ms, c->p99_ms);
+        ok = 0;
+    }
+    free(text);
+    return ok;
+}
+
+int main(void) {
+    size_t k, count = sizeof(cases) / sizeof(cases[0]);
+    int failed = 0;
+
+    for (k = 0; k < count; ++k) {
+        if (!run_case(&cases[k])) failed++;
+    }
+    printf("pacing: %zu cases, %d failed\n", count, failed);
+    return failed != 0;
+}
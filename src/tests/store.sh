@@ -0,0 +1,61 @@
+#!/bin/sh
+#
+# Stored frame tests for pride-nyancat.
+#
+# Frames are rendered without a terminal (-o) into an empty cache
+# directory, and the test fails unless the frames were built and a
+# file stored for them, also when the copy building them shares them
+# with others (-m). The frames are stored after the first one is on
+# its way, so that is checked too. A second run has to load them,
+# and write the same bytes as a run that built its own.
+#
+# usage: tests/store.sh path/to/pride-nyancat
+#
+# See pride-nyancat.c for copyright and licensing information.
+
+bin=$1
+cache=$(mktemp -d)
+trap 'rm -rf "$cache"' EXIT
+
+failed=0
+cases=0
+
+# Render a few frames with the options given to $cache/output,
+# printing what became of the stored frames
+render() {
+    env -i HOME=/nonexistent TERMINFO=/nonexistent TERM=xterm-256color XDG_CACHE_HOME="$cache" \
+        "$bin" -o 40x24 -f 4 -S "$@" 2>&1 >"$cache/output" | grep '^stored frames:'
+}
+
+# Check that a run with the options given built its frames and
+# stored them
+check_saved() {
+    cases=$((cases + 1))
+    rm -rf "$cache/pride-nyancat"
+    got=$(render "$@")
+    if [ "$got" != "stored frames: 0 loaded, 1 built" ]; then
+        echo "FAIL: $*: $got (expected them built)"
+        failed=$((failed + 1))
+    elif ! ls "$cache/pride-nyancat/"*.frames > /dev/null 2>&1; then
+        echo "FAIL: $*: nothing stored in $cache/pride-nyancat"
+        failed=$((failed + 1))
+    fi
+}
+
+check_saved -c
+check_saved -c -m
+
+cases=$((cases + 1))
+render > /dev/null
+mv "$cache/output" "$cache/built"
+got=$(render -c)
+if [ "$got" != "stored frames: 1 loaded, 0 built" ]; then
+    echo "FAIL: -c again: $got (expected them loaded)"
+    failed=$((failed + 1))
+elif ! cmp -s "$cache/built" "$cache/output"; then
+    echo "FAIL: -c again: the loaded frames differ from built ones"
+    failed=$((failed + 1))
+fi
+
+echo "store: $cases cases, $failed failed"
+[ $failed = 0 ]
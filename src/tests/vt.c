@@ -0,0 +1,356 @@
+/*
+ * A small model of an xterm-like screen, for the pride-nyancat tests.
+ *
+ * It keeps track of what every character cell shows, the cursor and
+ * the colors, for the part of xterm that pride-nyancat draws with:
+ * printing with autowrap, newlines (as CR LF, the way the terminal
+ * driver sends them on), cursor movement and saving, erasing with
+ * the background color, REP and SGR colors. Sequences that only
+ * change modes or ask for replies are skipped. Anything else is noted
+ * in vt->error, as the screen can't be trusted after that.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vt.h"
+
+enum {GROUND, ESCAPE, CSI, STRING, STRING_END};
+
+static void fail(struct vt *vt, const char *what, const char *seq) {
+    if (!vt->error[0]) {
+        snprintf(vt->error, sizeof(vt->error), "%s %.40s", what, seq);
+    }
+}
+
+static void blank(struct vt *vt, int x, int y, int n) {
+    while (n-- > 0 && x < vt->width) {
+        struct vt_cell *cell = vt_at(vt, x++, y);
+        cell->ch = ' ';
+        cell->fg = VT_DEFAULT;
+        cell->bg = vt->bg;
+    }
+}
+
+void vt_init(struct vt *vt, int width, int height) {
+    int y;
+    memset(vt, 0, sizeof(*vt));
+    vt->width = width;
+    vt->height = height;
+    vt->cells = malloc((size_t) width * height * sizeof(*vt->cells) + 1);
+    if (!vt->cells) {
+        perror("malloc");
+        exit(1);
+    }
+    for (y = 0; y < height; ++y) {
+        blank(vt, 0, y, width);
+    }
+    vt->last = ' ';
+}
+
+/*
+ * Change the size, keeping what fits from the top left like xterm
+ * does when the cursor stays on screen.
+ */
+void vt_resize(struct vt *vt, int width, int height) {
+    struct vt old = *vt;
+    int x, y;
+
+    vt_init(vt, width, height);
+    for (y = 0; y < height && y < old.height; ++y) {
+        for (x = 0; x < width && x < old.width; ++x) {
+            *vt_at(vt, x, y) = *vt_at(&old, x, y);
+        }
+    }
+    vt->x = old.x < width ? old.x : width - 1;
+    vt->y = old.y < height ? old.y : height - 1;
+    vt->saved_x = old.saved_x < width ? old.saved_x : width - 1;
+    vt->saved_y = old.saved_y < height ? old.saved_y : height - 1;
+    vt->fg = old.fg;
+    vt->bg = old.bg;
+    vt->last = old.last;
+    memcpy(vt->error, old.error, sizeof(vt->error));
+    free(old.cells);
+}
+
+void vt_free(struct vt *vt) {
+    free(vt->cells);
+    vt->cells = NULL;
+}
+
+static void line_feed(struct vt *vt) {
+    if (vt->y < vt->height - 1) {
+        vt->y++;
+        return;
+    }
+    /* Scroll up, the new line takes the background color */
+    memmove(vt->cells, vt->cells + vt->width, (size_t) (vt->height - 1) * vt->width * sizeof(*vt->cells));
+    blank(vt, 0, vt->height - 1, vt->width);
+}
+
+static void print(struct vt *vt, uint32_t ch) {
+    struct vt_cell *cell;
+    if (vt->pending) {
+        vt->x = 0;
+        line_feed(vt);
+        vt->pending = 0;
+    }
+    cell = vt_at(vt, vt->x, vt->y);
+    cell->ch = ch;
+    cell->fg = vt->fg;
+    cell->bg = vt->bg;
+    vt->last = ch;
+    if (vt->x == vt->width - 1) {
+        vt->pending = 1;
+    } else {
+        vt->x++;
+    }
+}
+
+static int clamp(int v, int lo, int hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+/*
+ * A color given as 5;n or 2;r;g;b after a 38 or 48, returning how
+ * many parameters it took.
+ */
+static int extended_color(struct vt *vt, const int *p, int n, uint32_t *color) {
+    if (n >= 2 && p[0] == 5) {
+        *color = VT_INDEXED(p[1] & 0xff);
+        return 2;
+    }
+    if (n >= 4 && p[0] == 2) {
+        *color = VT_RGB(p[1] & 0xff, p[2] & 0xff, p[3] & 0xff);
+        return 4;
+    }
+    fail(vt, "bad extended color in", vt->seq);
+    return n;
+}
+
+static void sgr(struct vt *vt, const int *p, int n) {
+    int k;
+    if (!n) {
+        vt->fg = vt->bg = VT_DEFAULT;
+    }
+    for (k = 0; k < n; ++k) {
+        int v = p[k];
+        if (v == 0) {
+            vt->fg = vt->bg = VT_DEFAULT;
+        } else if (v == 1 || v == 22) {
+            /* Bold only makes the counter brighter */
+        } else if (v >= 30 && v <= 37) {
+            vt->fg = VT_INDEXED(v - 30);
+        } else if (v >= 90 && v <= 97) {
+            vt->fg = VT_INDEXED(v - 90 + 8);
+        } else if (v >= 40 && v <= 47) {
+            vt->bg = VT_INDEXED(v - 40);
+        } else if (v >= 100 && v <= 107) {
+            vt->bg = VT_INDEXED(v - 100 + 8);
+        } else if (v == 39) {
+            vt->fg = VT_DEFAULT;
+        } else if (v == 49) {
+            vt->bg = VT_DEFAULT;
+        } else if (v == 38) {
+            k += extended_color(vt, p + k + 1, n - k - 1, &vt->fg);
+        } else if (v == 48) {
+            k += extended_color(vt, p + k + 1, n - k - 1, &vt->bg);
+        } else {
+            fail(vt, "unknown SGR in", vt->seq);
+        }
+    }
+}
+
+/*
+ * Carry out a control sequence, held in vt->seq without the ESC [.
+ */
+static void csi(struct vt *vt) {
+    int p[16], n = 0, k, y;
+    const char *s = vt->seq, *end = vt->seq + vt->len - 1;
+    char prefix = 0, final = *end;
+
+    if (*s == '?' || *s == '>' || *s == '=' || *s == '<') prefix = *s++;
+    while (s < end && n < 16) {
+        char *stop;
+        p[n++] = (int) strtol(s, &stop, 10);
+        s = stop;
+        if (*s != ';') break;
+        ++s;
+    }
+    if (s != end) {
+        /* Intermediate bytes, like DECRQM's $, are only used in queries */
+        if (final != 'p' && final != 'q') fail(vt, "unknown CSI", vt->seq);
+        return;
+    }
+    if (prefix) {
+        /* Private modes (alternate screen, cursor, synchronized output) and queries */
+        if (final != 'h' && final != 'l' && final != 'q' && final != 'c') fail(vt, "unknown CSI", vt->seq);
+        return;
+    }
+    int a = n ? p[0] : 0, count = a > 0 ? a : 1;
+    switch (final) {
+        case 'H':
+        case 'f':
+            vt->y = clamp((n >= 1 && p[0] > 0 ? p[0] : 1) - 1, 0, vt->height - 1);
+            vt->x = clamp((n >= 2 && p[1] > 0 ? p[1] : 1) - 1, 0, vt->width - 1);
+            vt->pending = 0;
+            break;
+        case 'A':
+            vt->y = clamp(vt->y - count, 0, vt->height - 1);
+            vt->pending = 0;
+            break;
+        case 'B':
+            vt->y = clamp(vt->y + count, 0, vt->height - 1);
+            vt->pending = 0;
+            break;
+        case 'C':
+            vt->x = clamp(vt->x + count, 0, vt->width - 1);
+            vt->pending = 0;
+            break;
+        case 'D':
+            vt->x = clamp(vt->x - count, 0, vt->width - 1);
+            vt->pending = 0;
+            break;
+        case 'G':
+            vt->x = clamp(count - 1, 0, vt->width - 1);
+            vt->pending = 0;
+            break;
+        case 'd':
+            vt->y = clamp(count - 1, 0, vt->height - 1);
+            vt->pending = 0;
+            break;
+        case 'J':
+            if (a == 0) {
+                blank(vt, vt->x, vt->y, vt->width);
+                for (y = vt->y + 1; y < vt->height; ++y) blank(vt, 0, y, vt->width);
+            } else if (a == 1) {
+                for (y = 0; y < vt->y; ++y) blank(vt, 0, y, vt->width);
+                blank(vt, 0, vt->y, vt->x + 1);
+            } else {
+                for (y = 0; y < vt->height; ++y) blank(vt, 0, y, vt->width);
+            }
+            break;
+        case 'K':
+            if (a == 0) {
+                blank(vt, vt->x, vt->y, vt->width);
+            } else if (a == 1) {
+                blank(vt, 0, vt->y, vt->x + 1);
+            } else {
+                blank(vt, 0, vt->y, vt->width);
+            }
+            break;
+        case 'X':
+            /* Erases from the cursor on without moving it */
+            blank(vt, vt->x, vt->y, count);
+            vt->pending = 0;
+            break;
+        case 'b':
+            for (k = 0; k < count; ++k) print(vt, vt->last);
+            break;
+        case 'm':
+            sgr(vt, p, n);
+            break;
+        case 's':
+            vt->saved_x = vt->x;
+            vt->saved_y = vt->y;
+            break;
+        case 'u':
+            vt->x = vt->saved_x;
+            vt->y = vt->saved_y;
+            vt->pending = 0;
+            break;
+        case 'n':
+        case 'c':
+            /* Cursor position and device attribute requests */
+            break;
+        default:
+            fail(vt, "unknown CSI", vt->seq);
+    }
+}
+
+void vt_feed(struct vt *vt, const char *data, size_t len) {
+    size_t k;
+    for (k = 0; k < len; ++k) {
+        unsigned char c = data[k];
+        switch (vt->state) {
+            case GROUND:
+                if (vt->more) {
+                    if ((c & 0xc0) != 0x80) {
+                        fail(vt, "bad UTF-8", "");
+                        vt->more = 0;
+                        break;
+                    }
+                    vt->code = vt->code << 6 | (c & 0x3f);
+                    if (!--vt->more) print(vt, vt->code);
+                } else if (c == '\033') {
+                    vt->state = ESCAPE;
+                } else if (c == '\n') {
+                    vt->x = 0;
+                    vt->pending = 0;
+                    line_feed(vt);
+                } else if (c == '\r') {
+                    vt->x = 0;
+                    vt->pending = 0;
+                } else if (c == '\a') {
+                    /* Nothing to see */
+                } else if (c < 0x20 || c == 0x7f) {
+                    fail(vt, "unknown control", "");
+                } else if (c < 0x80) {
+                    print(vt, c);
+                } else if ((c & 0xe0) == 0xc0) {
+                    vt->code = c & 0x1f;
+                    vt->more = 1;
+                } else if ((c & 0xf0) == 0xe0) {
+                    vt->code = c & 0x0f;
+                    vt->more = 2;
+                } else if ((c & 0xf8) == 0xf0) {
+                    vt->code = c & 0x07;
+                    vt->more = 3;
+                } else {
+                    fail(vt, "bad UTF-8", "");
+                }
+                break;
+            case ESCAPE:
+                vt->len = 0;
+                vt->state = GROUND;
+                if (c == '[') {
+                    vt->state = CSI;
+                } else if (c == 'P' || c == '_' || c == ']' || c == '^' || c == 'k') {
+                    /* Strings: device control, title and the like */
+                    vt->state = STRING;
+                } else if (c == '7') {
+                    vt->saved_x = vt->x;
+                    vt->saved_y = vt->y;
+                } else if (c == '8') {
+                    vt->x = vt->saved_x;
+                    vt->y = vt->saved_y;
+                    vt->pending = 0;
+                } else {
+                    char seq[2] = {c, 0};
+                    fail(vt, "unknown ESC", seq);
+                }
+                break;
+            case CSI:
+                if (vt->len < sizeof(vt->seq) - 1) vt->seq[vt->len++] = c;
+                if (c >= 0x40 && c <= 0x7e) {
+                    vt->seq[vt->len] = '\0';
+                    csi(vt);
+                    vt->state = GROUND;
+                }
+                break;
+            case STRING:
+                if (c == '\033') {
+                    vt->state = STRING_END;
+                } else if (c == '\a') {
+                    vt->state = GROUND;
+                }
+                break;
+            case STRING_END:
+                vt->state = c == '\\' ? GROUND : STRING;
+                break;
+        }
+    }
+}
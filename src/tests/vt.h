@@ -0,0 +1,67 @@
+/*
+ * A small model of an xterm-like screen, for the pride-nyancat tests.
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+#ifndef VT_H
+#define VT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Colors as the screen keeps them: the default, an entry of the
+ * 256-color palette (the 16 ANSI colors are its first entries) or
+ * an RGB value.
+ */
+#define VT_DEFAULT      0u
+#define VT_INDEXED(n)   (0x1000000u | (n))
+#define VT_RGB(r, g, b) (0x2000000u | (uint32_t) (r) << 16 | (uint32_t) (g) << 8 | (b))
+
+/*
+ * A character cell: the code point shown and its colors.
+ */
+struct vt_cell {
+    uint32_t ch;
+    uint32_t fg;
+    uint32_t bg;
+};
+
+/*
+ * The screen, the cursor and the colors it draws with. pending is
+ * set once a character went into the last column, the next one then
+ * goes on the next line. error describes the first sequence the model
+ * doesn't know, empty if there was none.
+ */
+struct vt {
+    int width;
+    int height;
+    struct vt_cell *cells;
+    int x;
+    int y;
+    int pending;
+    int saved_x;
+    int saved_y;
+    uint32_t fg;
+    uint32_t bg;
+    uint32_t last;      /* Last character printed, for REP */
+    char error[80];
+
+    /* Parser state, so that input may be fed in pieces */
+    int state;
+    char seq[64];
+    size_t len;
+    uint32_t code;      /* UTF-8 sequence being put together */
+    int more;           /* and the bytes it still needs */
+};
+
+void vt_init(struct vt *vt, int width, int height);
+void vt_resize(struct vt *vt, int width, int height);
+void vt_feed(struct vt *vt, const char *data, size_t len);
+void vt_free(struct vt *vt);
+
+static inline struct vt_cell *vt_at(struct vt *vt, int x, int y) {
+    return &vt->cells[(size_t) y * vt->width + x];
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * Show how two outputs of pride-nyancat differ, for the golden tests.
+ *
+ * Both are played on the screen model in vt.c, for a terminal of the
+ * given size. Where the bytes first differ is shown as text, then
+ * which cells of the screen differ with the last frame on it: a map
+ * of the screen, and the first few of them with their characters and
+ * colors.
+ *
+ *     tests/vtdiff COLUMNSxROWS expected actual
+ *
+ * See pride-nyancat.c for copyright and licensing information.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vt.h"
+
+#define CONTEXT 48
+#define MAX_LISTED 10
+
+static char *read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    char *data = NULL;
+    size_t size = 0, n;
+
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    *len = 0;
+    do {
+        if (*len == size) {
+            size = size ? 2 * size : 65536;
+            data = realloc(data, size);
+            if (!data) {
+                perror("realloc");
+                exit(2);
+            }
+        }
+        n = fread(data + *len, 1, size - *len, f);
+        *len += n;
+    } while (n);
+    fclose(f);
+    return data;
+}
+
+/*
+ * Bytes from a stream as text, escapes and all.
+ */
+static void show_bytes(const char *what, const char *data, size_t len, size_t from) {
+    size_t k, end = from + CONTEXT < len ? from + CONTEXT : len;
+    printf("  %-9s", what);
+    for (k = from; k < end; ++k) {
+        unsigned char c = data[k];
+        if (c == '\033') {
+            printf("\\e");
+        } else if (c == '\n') {
+            printf("\\n");
+        } else if (c < 0x20 || c >= 0x7f) {
+            printf("\\x%02x", c);
+        } else {
+            putchar(c);
+        }
+    }
+    printf("%s\n", end < len ? "..." : "");
+}
+
+/*
+ * The length of a stream up to where pride-nyancat clears the screen
+ * on the way out, so the last frame stays on it.
+ */
+static size_t before_exit(const char *data, size_t len) {
+    static const char *exits[] = {"\033[0m\033[H\033[2J\033[?1049l", "\033[0m\033[?1049l"};
+    size_t k, e;
+    for (k = len; k-- > 0;) {
+        for (e = 0; e < sizeof(exits) / sizeof(exits[0]); ++e) {
+            size_t n = strlen(exits[e]);
+            if (k + n <= len && !memcmp(data + k, exits[e], n)) return k;
+        }
+    }
+    return len;
+}
+
+static int same_cell(const struct vt_cell *a, const struct vt_cell *b) {
+    return a->ch == b->ch && a->fg == b->fg && a->bg == b->bg;
+}
+
+int main(int argc, char **argv) {
+    struct vt want, got;
+    char *expected, *actual;
+    size_t expected_len, actual_len, k;
+    int columns, rows, x, y, differ = 0;
+
+    if (argc != 4 || sscanf(argv[1], "%dx%d", &columns, &rows) != 2 || columns < 1 || rows < 1) {
+        fprintf(stderr, "usage: %s COLUMNSxROWS expected actual\n", argv[0]);
+        return 2;
+    }
+    expected = read_file(argv[2], &expected_len);
+    actual = read_file(argv[3], &actual_len);
+
+    for (k = 0; k < expected_len && k < actual_len && expected[k] == actual[k]; ++k);
+    if (k == expected_len && k == actual_len) {
+        printf("  the outputs are the same\n");
+        return 0;
+    }
+    printf("  %zu bytes expected, %zu bytes output, first different at byte %zu:\n",
+            expected_len, actual_len, k);
+    k = k > CONTEXT / 4 ? k - CONTEXT / 4 : 0;
+    show_bytes("expected", expected, expected_len, k);
+    show_bytes("output", actual, actual_len, k);
+
+    vt_init(&want, columns, rows);
+    vt_init(&got, columns, rows);
+    vt_feed(&want, expected, before_exit(expected, expected_len));
+    vt_feed(&got, actual, before_exit(actual, actual_len));
+    if (want.error[0]) printf("  expected: %s\n", want.error);
+    if (got.error[0]) printf("  output: %s\n", got.error);
+
+    for (y = 0; y < rows; ++y) {
+        for (x = 0; x < columns; ++x) {
+            if (!same_cell(vt_at(&want, x, y), vt_at(&got, x, y))) differ++;
+        }
+    }
+    if (!differ) {
+        printf("  the last frames look the same, an earlier one differs\n");
+    } else {
+        printf("  %d cells of the screen differ with the last frame on it (X):\n", differ);
+        for (y = 0; y < rows; ++y) {
+            printf("  |");
+            for (x = 0; x < columns; ++x) {
+                putchar(same_cell(vt_at(&want, x, y), vt_at(&got, x, y)) ? '.' : 'X');
+            }
+            printf("|\n");
+        }
+        differ = 0;
+        for (y = 0; y < rows && differ < MAX_LISTED; ++y) {
+            for (x = 0; x < columns && differ < MAX_LISTED; ++x) {
+                const struct vt_cell *a = vt_at(&got, x, y), *b = vt_at(&want, x, y);
+                if (same_cell(a, b)) continue;
+                printf("  cell %d,%d is U+%04x %07x on %07x, expected U+%04x %07x on %07x\n", x, y,
+                        (unsigned) a->ch, (unsigned) a->fg, (unsigned) a->bg,
+                        (unsigned) b->ch, (unsigned) b->fg, (unsigned) b->bg);
+                differ++;
+            }
+        }
+    }
+    if (want.x != got.x || want.y != got.y) {
+        printf("  the cursor ends up at %d,%d, expected %d,%d\n", got.x, got.y, want.x, want.y);
+    }
+
+    vt_free(&want);
+    vt_free(&got);
+    free(expected);
+    free(actual);
+    return 1;
+}